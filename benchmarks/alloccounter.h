@@ -0,0 +1,19 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstdint>
+
+namespace bench {
+
+/**
+ * @brief Heap allocations made by the whole process so far
+ *
+ * Counts malloc(), calloc() and realloc() calls, which also covers
+ * operator new and Qt's containers. Linking alloccounter.cpp interposes
+ * glibc's allocator, so do not combine it with sanitizers.
+ */
+[[nodiscard]] std::uint64_t allocationCount();
+
+} // namespace bench
+
+#endif // ALLOCCOUNTER_H
@@ -0,0 +1,117 @@
+/**
+ * @brief Event-loop latency of the GUI thread while scans run, with and without the scan thread
+ *
+ * Usage: bench_event_loop [--processes=N] [--seconds=S] [--interval-ms=I]
+ *
+ * A 1 ms precise timer on the main thread records how late each of its
+ * ticks fires, which is how long input and paint events would wait. A
+ * second timer asks for a full scan every I ms, in two modes:
+ *
+ *   blocking  the timer slot waits until the scan has published, as when
+ *             refreshProcessList_() scanned /proc on the GUI thread
+ *   worker    the timer slot only calls requestRefresh(); the scan runs on
+ *             ProcessManager's scan thread and the snapshot arrives queued
+ *
+ * Both modes do the same scans; rebuilding the tree model from a snapshot
+ * is left out so only collection is compared.
+ */
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QObject>
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <thread>
+#include <vector>
+
+#include "benchutil.h"
+#include "processmanager.h"
+
+namespace {
+
+constexpr int PROBE_INTERVAL_MS = 1;
+constexpr auto PUBLISH_POLL_INTERVAL = std::chrono::microseconds{200};
+
+/**
+ * @brief Sequence number of the latest published snapshot, 0 before the first
+ */
+quint64 snapshotSequence(const ProcessManager& manager) {
+    const ProcessSnapshotPtr snapshot = manager.snapshot();
+    return snapshot ? snapshot->sequence : 0;
+}
+
+/**
+ * @brief Run scans for a while and print how late the probe timer fired
+ * @param blocking Wait for each scan on the main thread instead of letting it run behind
+ */
+void measure(const char* label, ProcessManager& manager, bool blocking, long seconds, long intervalMs) {
+    std::vector<double> latenessMs;
+    long scans = 0;
+
+    QTimer probe;
+    probe.setTimerType(Qt::PreciseTimer);
+    probe.setInterval(PROBE_INTERVAL_MS);
+    bench::Clock::time_point lastTick = bench::Clock::now();
+    QObject::connect(&probe, &QTimer::timeout, [&] {
+        const bench::Clock::time_point now = bench::Clock::now();
+        const double gapMs = std::chrono::duration<double, std::milli>(now - lastTick).count();
+        latenessMs.push_back(std::max(0.0, gapMs - PROBE_INTERVAL_MS));
+        lastTick = now;
+    });
+
+    QTimer scanTimer;
+    scanTimer.setInterval(static_cast<int>(intervalMs));
+    QObject::connect(&scanTimer, &QTimer::timeout, [&] {
+        const quint64 before = snapshotSequence(manager);
+        manager.requestRefresh();
+        ++scans;
+        if (!blocking) {
+            return;
+        }
+        while (snapshotSequence(manager) == before) {
+            std::this_thread::sleep_for(PUBLISH_POLL_INTERVAL);
+        }
+    });
+
+    QEventLoop loop;
+    QTimer::singleShot(static_cast<int>(seconds * 1000), &loop, &QEventLoop::quit);
+    probe.start();
+    scanTimer.start();
+    loop.exec();
+
+    const bench::Summary summary = bench::summarize(latenessMs);
+    std::printf("%-10s %8ld %10.2f %10.2f %10.2f\n", label, scans, summary.median, summary.p99, summary.max);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::IdleProcesses idle;  // Before any threads exist
+    QCoreApplication app(argc, argv);
+
+    const long targetProcesses = bench::argument(argc, argv, "--processes", 0);
+    const long seconds = std::max(1L, bench::argument(argc, argv, "--seconds", 10));
+    const long intervalMs = std::max(1L, bench::argument(argc, argv, "--interval-ms", 250));
+
+    const procfs::FileDescriptor procDir(::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!procDir.isValid()) {
+        std::perror("/proc");
+        return 1;
+    }
+    const std::size_t processes = targetProcesses > 0
+        ? bench::padProcessCount(idle, procDir.get(), static_cast<std::size_t>(targetProcesses))
+        : bench::processCount(procDir.get());
+
+    ProcessManager manager;
+    manager.setColdSampleInterval(1);
+
+    std::printf("%zu processes, a scan every %ld ms for %ld s per mode\n\n", processes, intervalMs, seconds);
+    std::printf("%-10s %8s %10s %10s %10s\n", "mode", "scans", "late p50", "late p99", "late max");
+
+    measure("blocking", manager, true, seconds, intervalMs);
+    measure("worker", manager, false, seconds, intervalMs);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @brief Per-process cost of reading and parsing /proc, before and after procfs.h
+ *
+ * Usage: bench_procfs [--processes=N] [--rounds=R]
+ *
+ * Reads every process in /proc R times with each method and reports the
+ * median time per process and the heap allocations per process. With
+ * --processes, idle processes are forked first so /proc lists at least N
+ * processes. The parse-only rows tokenize stat lines that were read once
+ * up front, isolating the tokenizer from the syscalls.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "alloccounter.h"
+#include "benchutil.h"
+#include "procfs.h"
+#include "procfs_baseline.h"
+
+namespace {
+
+/**
+ * @brief Time R rounds of a per-process function over all PIDs and print one result row
+ */
+void measure(const char* label, const std::vector<int>& pids, long rounds, const std::function<bool(int)>& readOne) {
+    std::vector<double> nsPerProcess;
+    nsPerProcess.reserve(static_cast<std::size_t>(rounds));  // No allocations of our own inside a round
+    std::uint64_t allocations = 0;
+    std::size_t failures = 0;
+
+    for (long round = 0; round < rounds; ++round) {
+        const std::uint64_t allocationsBefore = bench::allocationCount();
+        const bench::Clock::time_point start = bench::Clock::now();
+        for (const int pid : pids) {
+            if (!readOne(pid)) {
+                ++failures;
+            }
+        }
+        nsPerProcess.push_back(bench::elapsedNs(start) / static_cast<double>(pids.size()));
+        allocations += bench::allocationCount() - allocationsBefore;
+    }
+
+    const bench::Summary summary = bench::summarize(nsPerProcess);
+    std::printf("%-36s %10.0f %10.0f %12.2f %8zu\n", label, summary.median, summary.max,
+                static_cast<double>(allocations) / static_cast<double>(pids.size() * static_cast<std::size_t>(rounds)),
+                failures);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long targetProcesses = bench::argument(argc, argv, "--processes", 0);
+    const long rounds = std::max(1L, bench::argument(argc, argv, "--rounds", 20));
+
+    bench::IdleProcesses idle;
+
+    const procfs::FileDescriptor procDir(::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!procDir.isValid()) {
+        std::perror("/proc");
+        return 1;
+    }
+
+    if (targetProcesses > 0) {
+        bench::padProcessCount(idle, procDir.get(), static_cast<std::size_t>(targetProcesses));
+    }
+
+    std::vector<int> pids;
+    if (!procfs::listProcessIds(procDir.get(), pids) || pids.empty()) {
+        std::fprintf(stderr, "No processes found in /proc\n");
+        return 1;
+    }
+
+    // Stat lines for the parse-only rows
+    std::vector<std::string> statLines;
+    for (const int pid : pids) {
+        char path[32];
+        char buffer[procfs::STAT_BUFFER_SIZE];
+        const ssize_t length = procfs::readFileAt(procDir.get(), procfs::formatProcessPath(pid, "stat", path, sizeof(path)),
+                                                  buffer, sizeof(buffer));
+        statLines.emplace_back(buffer, length > 0 ? static_cast<std::size_t>(length) : 0);
+    }
+    std::vector<int> lineIndices(statLines.size());
+    for (std::size_t i = 0; i < lineIndices.size(); ++i) {
+        lineIndices[i] = static_cast<int>(i);
+    }
+
+    std::printf("%zu processes, %ld rounds\n\n", pids.size(), rounds);
+    std::printf("%-36s %10s %10s %12s %8s\n", "method", "ns/proc", "max", "allocs/proc", "failed");
+
+    measure("QFile/QTextStream/split (before)", pids, rounds, [](int pid) {
+        return baseline::readProcess(pid);
+    });
+
+    measure("openat/read/close + parseStat", pids, rounds, [&procDir](int pid) {
+        char path[32];
+        char buffer[procfs::STAT_BUFFER_SIZE];
+        const ssize_t length = procfs::readFileAt(procDir.get(), procfs::formatProcessPath(pid, "stat", path, sizeof(path)),
+                                                  buffer, sizeof(buffer));
+        procfs::ProcessStat stat;
+        return length > 0 && procfs::parseStat(buffer, static_cast<std::size_t>(length), stat);
+    });
+
+    // Steady state of a scan: descriptors stay open, so the first round pays the opens
+    procfs::ProcessFileCache::raiseDescriptorLimit();
+    procfs::ProcessFileCache cache;
+    measure("cached descriptor + parseStat", pids, rounds, [&procDir, &cache](int pid) {
+        char buffer[procfs::STAT_BUFFER_SIZE];
+        const ssize_t length = cache.read(procDir.get(), pid, procfs::ProcessFile::Stat, buffer, sizeof(buffer));
+        procfs::ProcessStat stat;
+        return length > 0 && procfs::parseStat(buffer, static_cast<std::size_t>(length), stat);
+    });
+
+    measure("parse only: QString::split (before)", lineIndices, rounds, [&statLines](int index) {
+        const std::string& line = statLines[static_cast<std::size_t>(index)];
+        return baseline::parseStat(line.data(), line.size());
+    });
+
+    measure("parse only: procfs::parseStat", lineIndices, rounds, [&statLines](int index) {
+        const std::string& line = statLines[static_cast<std::size_t>(index)];
+        procfs::ProcessStat stat;
+        return procfs::parseStat(line.data(), line.size(), stat);
+    });
+
+    return 0;
+}
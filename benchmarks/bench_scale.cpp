@@ -0,0 +1,167 @@
+/**
+ * @brief Scan-to-screen latency at 100k synthetic processes, checked against a budget
+ *
+ * Usage: bench_scale [--processes=100000] [--ticks=R] [--budget-ms=B]
+ *
+ * Few hosts can run 100k real processes, so this feeds synthetic
+ * /proc/[PID]/stat lines with PIDs spread up to kernel.pid_max's ceiling
+ * of 4194304 through the same stages as a real tick:
+ *
+ *   scan  ProcessManager::scanStatContents(): parsing, sampling tiers, row
+ *         updates, CPU baselines, memory history, pruning and publishing
+ *         the snapshot, until processesUpdated() arrives on this thread
+ *   gui   MainWindow rebuilding its model and view from the snapshot
+ *
+ * Counters change every tick so every row is updated. Both tree layouts are
+ * measured; the run fails (exit status 1) if the median total of either
+ * exceeds the budget, by default half of the 2 s refresh interval. The
+ * window is shown on the offscreen platform unless QT_QPA_PLATFORM is set.
+ */
+
+#include <QApplication>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QMetaObject>
+#include <QPushButton>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchutil.h"
+#include "mainwindow.h"
+#include "processmanager.h"
+#include "processsnapshot.h"
+#include "procfs.h"
+
+namespace {
+
+constexpr int SYNTHETIC_NAME_COUNT = 2000;  // Distinct names; most processes share one
+constexpr int TREE_FAN_OUT = 8;  // Children per synthetic parent
+constexpr qint64 STARTUP_SETTLE_MS = 2000;  // Lets the window's own first scan arrive before measuring
+
+/**
+ * @brief PID of the i-th synthetic process, spread evenly over the largest pid_max
+ */
+int syntheticPid(std::size_t index, std::size_t count) {
+    return 2 + static_cast<int>(index * static_cast<std::size_t>(procfs::PID_MAX_LIMIT - 2) / count);
+}
+
+/**
+ * @brief PIDs and /proc/[PID]/stat lines of all synthetic processes as of one tick
+ */
+void makeStatLines(std::size_t count, int tick, std::vector<int>& pids, std::vector<std::string>& lines) {
+    pids.resize(count);
+    lines.resize(count);
+    char buffer[procfs::STAT_BUFFER_SIZE];
+    for (std::size_t i = 0; i < count; ++i) {
+        const int parent = i == 0 ? 0 : syntheticPid((i - 1) / TREE_FAN_OUT, count);
+        const unsigned long long utime = i % 7 + static_cast<unsigned long long>(tick) * (i % 3);
+        const long rssPages = static_cast<long>(256 + i % 4096 + static_cast<std::size_t>(tick) * (i % 5));
+        pids[i] = syntheticPid(i, count);
+        const int length = std::snprintf(
+            buffer, sizeof(buffer),
+            "%d (worker-%zu) S %d %d %d 0 -1 4194304 100 0 0 0 %llu %llu 0 0 20 %d 1 0 %zu 10485760 %ld "
+            "18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 %zu 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+            pids[i], i % SYNTHETIC_NAME_COUNT, parent, parent, parent, utime, utime / 2,
+            static_cast<int>(i % 40) - 20, 1000 + i, rssPages, i % 64);
+        lines[i].assign(buffer, static_cast<std::size_t>(length));
+    }
+}
+
+/**
+ * @brief Run one synthetic scan through ProcessManager and wait for its snapshot
+ */
+ProcessSnapshotPtr scan(ProcessManager& manager, std::vector<int> pids, std::vector<std::string> lines) {
+    ProcessSnapshotPtr published;
+    QEventLoop loop;
+    const QMetaObject::Connection connection = QObject::connect(
+        &manager, &ProcessManager::processesUpdated, &loop, [&](const ProcessSnapshotPtr& snapshot) {
+            published = snapshot;
+            loop.quit();
+        });
+    manager.scanStatContents(std::move(pids), std::move(lines));
+    loop.exec();
+    QObject::disconnect(connection);
+    return published;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    const std::size_t processes =
+        static_cast<std::size_t>(std::max(1L, bench::argument(argc, argv, "--processes", 100000)));
+    const long ticks = std::max(1L, bench::argument(argc, argv, "--ticks", 10));
+    const double budgetMs = static_cast<double>(bench::argument(argc, argv, "--budget-ms", 1000));
+
+    MainWindow window;
+    window.show();
+
+    // Stop the window's own scans; only synthetic snapshots are shown from here on
+    for (QPushButton* button : window.findChildren<QPushButton*>()) {
+        if (button->text() == "Auto Refresh") {
+            button->setChecked(false);
+        }
+    }
+    QElapsedTimer settle;
+    settle.start();
+    while (settle.elapsed() < STARTUP_SETTLE_MS) {
+        QApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+
+    QComboBox* layoutBox = window.findChild<QComboBox*>();
+    if (!layoutBox) {
+        std::fprintf(stderr, "Layout selector not found\n");
+        return 1;
+    }
+
+    std::printf("%zu synthetic processes, %ld ticks per layout, budget %.0f ms\n\n", processes, ticks, budgetMs);
+    std::printf("%-14s %10s %10s %10s %10s\n", "layout", "scan ms", "gui ms", "total ms", "max ms");
+
+    bool withinBudget = true;
+    for (int layout = 0; layout < layoutBox->count(); ++layout) {
+        layoutBox->setCurrentIndex(layout);
+
+        ProcessManager manager;  // Starts empty for every layout, like the window's own
+        std::vector<double> scanMs;
+        std::vector<double> guiMs;
+        std::vector<double> totalMs;
+        for (long tick = 0; tick <= ticks; ++tick) {
+            std::vector<int> pids;
+            std::vector<std::string> lines;
+            makeStatLines(processes, static_cast<int>(tick), pids, lines);
+
+            bench::Clock::time_point start = bench::Clock::now();
+            const ProcessSnapshotPtr published = scan(manager, std::move(pids), std::move(lines));
+            const double scanTime = bench::elapsedNs(start) / 1e6;
+
+            start = bench::Clock::now();
+            QMetaObject::invokeMethod(&window, "onProcessesUpdated_", Qt::DirectConnection,
+                                      Q_ARG(ProcessSnapshotPtr, published));
+            QApplication::processEvents();  // Layout and paint of the view
+            const double guiTime = bench::elapsedNs(start) / 1e6;
+
+            if (tick == 0) {
+                continue;  // Warm-up: every name and row is new
+            }
+            scanMs.push_back(scanTime);
+            guiMs.push_back(guiTime);
+            totalMs.push_back(scanTime + guiTime);
+        }
+
+        const bench::Summary total = bench::summarize(totalMs);
+        std::printf("%-14s %10.1f %10.1f %10.1f %10.1f\n", qPrintable(layoutBox->itemText(layout)),
+                    bench::summarize(scanMs).median, bench::summarize(guiMs).median, total.median, total.max);
+        withinBudget = withinBudget && total.median <= budgetMs;
+    }
+
+    std::printf("\n%s\n", withinBudget ? "PASS: within budget" : "FAIL: over budget");
+    return withinBudget ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/**
+ * @brief Full-scan latency of ProcessManager against the number of scan threads
+ *
+ * Usage: bench_scan_threads [--processes=1000,10000,50000] [--threads=1,2,4,8] [--scans=R]
+ *
+ * For every process count, idle processes are forked until /proc lists that
+ * many processes; then each thread count runs R full scans and reports the
+ * median and slowest. A scan is timed from requestRefresh() until
+ * processesUpdated() arrives, so it includes building and publishing the
+ * snapshot. Every process is read on every scan (cold sampling is turned
+ * off) and descriptors are cached by the warm-up scans, which is the
+ * steady state of a long-running monitor.
+ */
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QObject>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <vector>
+
+#include "benchutil.h"
+#include "processmanager.h"
+
+namespace {
+
+constexpr int WARM_UP_SCANS = 2;
+
+/**
+ * @brief Run one full scan and wait for its snapshot
+ * @return Milliseconds from the request to the processesUpdated() signal
+ */
+double timeScan(ProcessManager& manager) {
+    QEventLoop loop;
+    const QMetaObject::Connection connection =
+        QObject::connect(&manager, &ProcessManager::processesUpdated, &loop, &QEventLoop::quit);
+
+    const bench::Clock::time_point start = bench::Clock::now();
+    manager.requestRefresh();
+    loop.exec();
+    const double elapsedMs = bench::elapsedNs(start) / 1e6;
+
+    QObject::disconnect(connection);
+    return elapsedMs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::IdleProcesses idle;  // Before any threads exist
+    QCoreApplication app(argc, argv);
+
+    const std::vector<long> processCounts = bench::listArgument(argc, argv, "--processes", {1000, 10000, 50000});
+    const std::vector<long> threadCounts = bench::listArgument(argc, argv, "--threads", {1, 2, 4, 8});
+    const long scans = std::max(1L, bench::argument(argc, argv, "--scans", 10));
+
+    const procfs::FileDescriptor procDir(::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!procDir.isValid()) {
+        std::perror("/proc");
+        return 1;
+    }
+
+    std::printf("%d CPUs online, %ld scans per row\n\n", QThread::idealThreadCount(), scans);
+    std::printf("%10s %8s %12s %12s %14s\n", "processes", "threads", "median ms", "max ms", "us/process");
+
+    ProcessManager manager;
+    manager.setColdSampleInterval(1);
+
+    for (const long target : processCounts) {
+        const std::size_t processes = bench::padProcessCount(idle, procDir.get(), static_cast<std::size_t>(target));
+        if (processes < static_cast<std::size_t>(target)) {
+            std::printf("%10zu (wanted %ld; raise kernel.pid_max or ulimit -u)\n", processes, target);
+        }
+
+        for (const long threads : threadCounts) {
+            manager.setScanThreadCount(static_cast<int>(threads));
+            for (int i = 0; i < WARM_UP_SCANS; ++i) {
+                timeScan(manager);
+            }
+
+            std::vector<double> samples;
+            for (long i = 0; i < scans; ++i) {
+                samples.push_back(timeScan(manager));
+            }
+
+            const bench::Summary summary = bench::summarize(samples);
+            std::printf("%10zu %8ld %12.2f %12.2f %14.2f\n", processes, threads, summary.median, summary.max,
+                        summary.median * 1000.0 / static_cast<double>(processes));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @brief Resident memory of ProcessManager over a long run with heavy process churn
+ *
+ * Usage: bench_soak [--ticks=T] [--churn=K] [--report-every=N] [--max-growth-kib=G]
+ *
+ * Every tick replaces K short-lived processes with K new ones and runs a
+ * full scan, so each scan sees K exits and K new processes whose memory
+ * history, CPU baselines and sampling state must be created and later
+ * swept. New PIDs keep coming as the kernel wraps around pid_max, as on a
+ * CI host running millions of short jobs. Resident memory is printed every
+ * N ticks; the run fails (exit status 1) if it ends more than G KiB above
+ * where it stood after the warm-up ticks.
+ */
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QObject>
+#include <algorithm>
+#include <cstdio>
+
+#include "benchutil.h"
+#include "processmanager.h"
+
+namespace {
+
+constexpr long WARM_UP_TICKS = 20;  // Lets allocator pools and table capacity settle
+
+/**
+ * @brief Run one full scan and wait for its snapshot
+ */
+void scanOnce(ProcessManager& manager) {
+    QEventLoop loop;
+    const QMetaObject::Connection connection =
+        QObject::connect(&manager, &ProcessManager::processesUpdated, &loop, &QEventLoop::quit);
+    manager.requestRefresh();
+    loop.exec();
+    QObject::disconnect(connection);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::IdleProcesses churn;  // Before any threads exist
+    QCoreApplication app(argc, argv);
+
+    const long ticks = std::max(1L, bench::argument(argc, argv, "--ticks", 2000));
+    const long churnPerTick = std::max(1L, bench::argument(argc, argv, "--churn", 500));
+    const long reportEvery = std::max(1L, bench::argument(argc, argv, "--report-every", 100));
+    const long maxGrowthKiB = bench::argument(argc, argv, "--max-growth-kib", 4096);
+
+    ProcessManager manager;
+    manager.setColdSampleInterval(1);
+
+    std::printf("%ld ticks, %ld processes replaced per tick\n\n", ticks, churnPerTick);
+    std::printf("%8s %14s %12s %12s\n", "tick", "processes seen", "RSS KiB", "vs warm KiB");
+
+    long warmKiB = 0;
+    long lastKiB = 0;
+    std::size_t processesSeen = 0;
+    for (long tick = 1; tick <= WARM_UP_TICKS + ticks; ++tick) {
+        churn.resize(0);
+        churn.resize(static_cast<std::size_t>(churnPerTick));
+        scanOnce(manager);
+        processesSeen += churn.size();
+
+        if (tick == WARM_UP_TICKS) {
+            warmKiB = bench::residentKiB();
+        }
+        if (tick > WARM_UP_TICKS && (tick - WARM_UP_TICKS) % reportEvery == 0) {
+            lastKiB = bench::residentKiB();
+            std::printf("%8ld %14zu %12ld %+12ld\n", tick - WARM_UP_TICKS, processesSeen, lastKiB, lastKiB - warmKiB);
+            std::fflush(stdout);
+        }
+    }
+
+    lastKiB = bench::residentKiB();
+    const bool flat = lastKiB - warmKiB <= maxGrowthKiB;
+    std::printf("\n%s: RSS %ld KiB after warm-up, %ld KiB at the end (limit +%ld KiB)\n", flat ? "PASS" : "FAIL",
+                warmKiB, lastKiB, maxGrowthKiB);
+    return flat ? 0 : 1;
+}
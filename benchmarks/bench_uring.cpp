@@ -0,0 +1,146 @@
+/**
+ * @brief Reading /proc/[PID]/stat of every process: io_uring batches against synchronous reads
+ *
+ * Usage: bench_uring [--processes=1000,10000] [--rounds=R] [--entries=E]
+ *
+ * For every process count, idle processes are forked until /proc lists
+ * that many, then each backend reads the stat file of every process R
+ * times. "sync" is one openat/read/close per file, the synchronous
+ * backend's path for a PID it has no cached descriptor for; "sync cached"
+ * is its steady state with pread() on kept descriptors; "io_uring" is
+ * UringReader with E submission entries per batch, as ProcessManager uses
+ * it. Reports the median time per pass and per process.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "benchutil.h"
+#include "procfs.h"
+#include "uringreader.h"
+
+namespace {
+
+/**
+ * @brief Time R passes over all PIDs and print one result row
+ * @param readAll Reads every PID once; returns the number read successfully
+ */
+void measure(const char* label, std::size_t processes, long rounds, const std::function<std::size_t()>& readAll) {
+    std::vector<double> passMs;
+    std::size_t read = 0;
+    for (long round = 0; round < rounds; ++round) {
+        const bench::Clock::time_point start = bench::Clock::now();
+        read = readAll();
+        passMs.push_back(bench::elapsedNs(start) / 1e6);
+    }
+
+    const bench::Summary summary = bench::summarize(passMs);
+    std::printf("%10zu %-12s %10.2f %10.2f %12.2f %8zu\n", processes, label, summary.median, summary.max,
+                summary.median * 1000.0 / static_cast<double>(processes), read);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::IdleProcesses idle;
+
+    const std::vector<long> processCounts = bench::listArgument(argc, argv, "--processes", {1000, 10000});
+    const long rounds = std::max(1L, bench::argument(argc, argv, "--rounds", 10));
+    const long entries = std::max(1L, bench::argument(argc, argv, "--entries", procfs::UringReader::DEFAULT_ENTRIES));
+
+    const procfs::FileDescriptor procDir(::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!procDir.isValid()) {
+        std::perror("/proc");
+        return 1;
+    }
+
+    const std::unique_ptr<procfs::UringReader> uring = procfs::UringReader::create(static_cast<unsigned>(entries));
+    if (!uring) {
+        std::printf("io_uring is unavailable; only the synchronous rows are measured\n");
+    }
+
+    procfs::ProcessFileCache::raiseDescriptorLimit();
+
+    std::printf("%ld passes per row, %ld io_uring entries\n\n", rounds, entries);
+    std::printf("%10s %-12s %10s %10s %12s %8s\n", "processes", "backend", "median ms", "max ms", "us/process", "read");
+
+    std::vector<int> pids;
+    std::vector<char> buffers;
+    std::vector<procfs::UringReader::Request> requests;
+    for (const long target : processCounts) {
+        bench::padProcessCount(idle, procDir.get(), static_cast<std::size_t>(target));
+        if (!procfs::listProcessIds(procDir.get(), pids)) {
+            std::perror("/proc");
+            return 1;
+        }
+
+        measure("sync", pids.size(), rounds, [&] {
+            std::size_t read = 0;
+            for (const int pid : pids) {
+                char path[32];
+                char buffer[procfs::STAT_BUFFER_SIZE];
+                procfs::ProcessStat stat;
+                const ssize_t length = procfs::readFileAt(
+                    procDir.get(), procfs::formatProcessPath(pid, "stat", path, sizeof(path)), buffer, sizeof(buffer));
+                read += length > 0 && procfs::parseStat(buffer, static_cast<std::size_t>(length), stat);
+            }
+            return read;
+        });
+
+        {
+            // Closed again before the io_uring row, which needs descriptors of its own
+            procfs::ProcessFileCache cache;
+            measure("sync cached", pids.size(), rounds, [&] {
+                std::size_t read = 0;
+                for (const int pid : pids) {
+                    char buffer[procfs::STAT_BUFFER_SIZE];
+                    procfs::ProcessStat stat;
+                    const ssize_t length =
+                        cache.read(procDir.get(), pid, procfs::ProcessFile::Stat, buffer, sizeof(buffer));
+                    read += length > 0 && procfs::parseStat(buffer, static_cast<std::size_t>(length), stat);
+                }
+                return read;
+            });
+        }
+
+        if (!uring) {
+            continue;
+        }
+
+        const std::size_t batchSize = uring->entries();
+        requests.resize(batchSize);
+        buffers.resize(batchSize * procfs::STAT_BUFFER_SIZE);
+        measure("io_uring", pids.size(), rounds, [&] {
+            std::size_t read = 0;
+            for (std::size_t batchStart = 0; batchStart < pids.size(); batchStart += batchSize) {
+                const std::size_t batchLength = std::min(pids.size() - batchStart, batchSize);
+                for (std::size_t b = 0; b < batchLength; ++b) {
+                    procfs::UringReader::Request& request = requests[b];
+                    request.pid = pids[batchStart + b];
+                    request.file = procfs::ProcessFile::Stat;
+                    request.buffer = buffers.data() + b * procfs::STAT_BUFFER_SIZE;
+                    request.capacity = procfs::STAT_BUFFER_SIZE;
+                }
+
+                if (!uring->readAll(procDir.get(), requests.data(), batchLength)) {
+                    std::fprintf(stderr, "io_uring submission failed\n");
+                    return read;
+                }
+
+                for (std::size_t b = 0; b < batchLength; ++b) {
+                    procfs::ProcessStat stat;
+                    const procfs::UringReader::Request& request = requests[b];
+                    read += request.result > 0 &&
+                        procfs::parseStat(request.buffer, static_cast<std::size_t>(request.result), stat);
+                }
+            }
+            return read;
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,255 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/prctl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "procfs.h"
+
+/**
+ * @brief Small helpers shared by the benchmark executables
+ *
+ * Header-only on purpose: every benchmark is a single translation unit plus
+ * the sources it measures.
+ */
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Nanoseconds elapsed since a time point
+ */
+inline double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Median, 99th percentile and maximum of a set of samples
+ */
+struct Summary {
+    double median = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+inline Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    summary.median = samples[samples.size() / 2];
+    summary.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    summary.max = samples.back();
+    return summary;
+}
+
+/**
+ * @brief Integer value of a "--name=value" argument, or a default
+ */
+inline long argument(int argc, char** argv, const char* name, long defaultValue) {
+    const std::size_t nameLength = std::strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], name, nameLength) == 0 && argv[i][nameLength] == '=') {
+            return std::strtol(argv[i] + nameLength + 1, nullptr, 10);
+        }
+    }
+    return defaultValue;
+}
+
+/**
+ * @brief Comma-separated integer list of a "--name=a,b,c" argument, or a default
+ */
+inline std::vector<long> listArgument(int argc, char** argv, const char* name, std::vector<long> defaultValue) {
+    const std::size_t nameLength = std::strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], name, nameLength) != 0 || argv[i][nameLength] != '=') {
+            continue;
+        }
+
+        std::vector<long> values;
+        const char* cursor = argv[i] + nameLength + 1;
+        while (*cursor) {
+            char* next = nullptr;
+            const long value = std::strtol(cursor, &next, 10);
+            if (next == cursor) {
+                break;  // Not a number
+            }
+            values.push_back(value);
+            cursor = *next == ',' ? next + 1 : next;
+        }
+        return values;
+    }
+    return defaultValue;
+}
+
+/**
+ * @brief Number of processes currently listed in /proc
+ */
+inline std::size_t processCount(int procDirFd) {
+    std::vector<int> pids;
+    return procfs::listProcessIds(procDirFd, pids) ? pids.size() : 0;
+}
+
+/**
+ * @brief Resident set size of this process in KiB, from /proc/self/statm
+ */
+inline long residentKiB() {
+    char buffer[128];
+    const ssize_t length = procfs::readFile("/proc/self/statm", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return -1;
+    }
+
+    const char* cursor = buffer;
+    unsigned long long sizePages = 0;
+    unsigned long long residentPages = 0;
+    if (!procfs::parseUnsigned(cursor, buffer + length, sizePages) ||
+        !procfs::parseUnsigned(cursor, buffer + length, residentPages)) {
+        return -1;
+    }
+    return static_cast<long>(residentPages * static_cast<unsigned long long>(::sysconf(_SC_PAGESIZE)) / 1024);
+}
+
+/**
+ * @brief Idle processes that pad /proc up to a target process count
+ *
+ * The processes are forked by a helper process that is itself forked in
+ * the constructor, so they inherit neither the benchmark's threads nor its
+ * cached /proc descriptors. Construct this before starting threads or
+ * opening many files. Each idle process blocks in pause(); all of them die
+ * with the benchmark through PR_SET_PDEATHSIG, so an interrupted run
+ * leaves nothing behind.
+ */
+class IdleProcesses {
+public:
+    IdleProcesses() {
+        int requestPipe[2];
+        int replyPipe[2];
+        if (::pipe2(requestPipe, O_CLOEXEC) != 0 || ::pipe2(replyPipe, O_CLOEXEC) != 0) {
+            std::perror("pipe2");
+            return;
+        }
+
+        const pid_t parent = ::getpid();
+        m_spawner = ::fork();
+        if (m_spawner == 0) {
+            ::close(requestPipe[1]);
+            ::close(replyPipe[0]);
+            dieWithParent_(parent);
+            runSpawner_(requestPipe[0], replyPipe[1]);
+        }
+
+        ::close(requestPipe[0]);
+        ::close(replyPipe[1]);
+        m_request.reset(requestPipe[1]);
+        m_reply.reset(replyPipe[0]);
+    }
+
+    ~IdleProcesses() {
+        m_request.reset();  // The spawner kills its processes on EOF
+        if (m_spawner > 0) {
+            ::waitpid(m_spawner, nullptr, 0);
+        }
+    }
+
+    IdleProcesses(const IdleProcesses&) = delete;
+    IdleProcesses& operator=(const IdleProcesses&) = delete;
+
+    /**
+     * @brief Fork or kill idle processes until there are count of them
+     * @return Processes running afterwards; fewer than asked if fork() failed
+     *         (RLIMIT_NPROC, kernel.pid_max or memory)
+     */
+    std::size_t resize(std::size_t count) {
+        if (::write(m_request.get(), &count, sizeof(count)) != sizeof(count) ||
+            ::read(m_reply.get(), &m_size, sizeof(m_size)) != sizeof(m_size)) {
+            std::perror("idle process spawner");
+        }
+        return m_size;
+    }
+
+    [[nodiscard]] std::size_t size() const { return m_size; }
+
+private:
+    static void dieWithParent_(pid_t parent) {
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (::getppid() != parent) {
+            ::_exit(0);  // Parent already gone
+        }
+    }
+
+    [[noreturn]] static void runSpawner_(int requestFd, int replyFd) {
+        std::vector<pid_t> pids;
+        std::size_t count = 0;
+        while (::read(requestFd, &count, sizeof(count)) == sizeof(count)) {
+            while (pids.size() > count) {
+                ::kill(pids.back(), SIGKILL);
+                ::waitpid(pids.back(), nullptr, 0);
+                pids.pop_back();
+            }
+
+            const pid_t spawner = ::getpid();
+            while (pids.size() < count) {
+                const pid_t pid = ::fork();
+                if (pid < 0) {
+                    std::fprintf(stderr, "fork() failed after %zu idle processes: %s\n", pids.size(),
+                                 std::strerror(errno));
+                    break;
+                }
+                if (pid == 0) {
+                    dieWithParent_(spawner);
+                    for (;;) {
+                        ::pause();
+                    }
+                }
+                pids.push_back(pid);
+            }
+
+            const std::size_t running = pids.size();
+            if (::write(replyFd, &running, sizeof(running)) != sizeof(running)) {
+                break;
+            }
+        }
+
+        for (const pid_t pid : pids) {
+            ::kill(pid, SIGKILL);
+        }
+        for (const pid_t pid : pids) {
+            ::waitpid(pid, nullptr, 0);
+        }
+        ::_exit(0);
+    }
+
+    pid_t m_spawner = -1;
+    procfs::FileDescriptor m_request;
+    procfs::FileDescriptor m_reply;
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief Add idle processes until /proc lists at least target processes
+ * @return Processes listed in /proc afterwards
+ */
+inline std::size_t padProcessCount(IdleProcesses& idle, int procDirFd, std::size_t target) {
+    const std::size_t others = processCount(procDirFd) - idle.size();
+    idle.resize(target > others ? target - others : 0);
+    return processCount(procDirFd);
+}
+
+} // namespace bench
+
+#endif // BENCHUTIL_H
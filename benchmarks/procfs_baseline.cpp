@@ -0,0 +1,108 @@
+#include "procfs_baseline.h"
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+namespace baseline {
+
+namespace {
+
+/**
+ * @brief Keeps parsed values alive so the compiler cannot drop the parsing
+ */
+volatile double sink = 0.0;
+
+/**
+ * @brief First line of a /proc file, or an empty string if it cannot be opened
+ */
+QString readFirstLine(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+
+    QTextStream stream(&file);
+    return stream.readLine();
+}
+
+/**
+ * @brief VmRSS from /proc/[PID]/status in MB, as readProcessMemory_() did
+ */
+double readMemory(int pid) {
+    QFile statusFile(QString("/proc/%1/status").arg(pid));
+    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0.0;
+    }
+
+    QTextStream stream(&statusFile);
+    QString line;
+    while (stream.readLineInto(&line)) {
+        if (line.startsWith("VmRSS:")) {
+            const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+            if (parts.size() >= 3) {
+                return parts[1].toLong() / 1024.0;
+            }
+            break;
+        }
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Lifetime CPU% from /proc/[PID]/stat and /proc/uptime, as readProcessCpu_() did
+ */
+double readCpu(int pid) {
+    const QStringList parts = readFirstLine(QString("/proc/%1/stat").arg(pid)).split(' ', Qt::SkipEmptyParts);
+    if (parts.size() < 16) {
+        return 0.0;
+    }
+    const unsigned long totalTime = parts[13].toULong() + parts[14].toULong();
+
+    const QStringList uptimeParts = readFirstLine("/proc/uptime").split(' ', Qt::SkipEmptyParts);
+    if (uptimeParts.isEmpty()) {
+        return 0.0;
+    }
+    const double uptime = uptimeParts[0].toDouble();
+    return uptime > 0 ? totalTime / 100.0 / uptime * 100.0 : 0.0;
+}
+
+/**
+ * @brief Field of /proc/[PID]/stat by zero-based index, as the state and priority readers did
+ */
+QString readStatField(int pid, int index) {
+    const QStringList parts = readFirstLine(QString("/proc/%1/stat").arg(pid)).split(' ', Qt::SkipEmptyParts);
+    return parts.size() > index ? parts[index] : QString();
+}
+
+} // namespace
+
+bool readProcess(int pid) {
+    const QString name = readFirstLine(QString("/proc/%1/comm").arg(pid)).trimmed();
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    const double memoryMB = readMemory(pid);
+    const double cpuPercent = readCpu(pid);
+    const QString state = readStatField(pid, 2);
+    const int nice = readStatField(pid, 18).toInt();
+
+    sink = memoryMB + cpuPercent + nice + (state == "T" ? 1 : 0) + name.size();
+    return true;
+}
+
+bool parseStat(const char* data, std::size_t length) {
+    const QString line = QString::fromUtf8(data, static_cast<qsizetype>(length));
+    const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+    if (parts.size() < 24) {
+        return false;
+    }
+
+    sink = parts[3].toInt() + parts[13].toULong() + parts[14].toULong() + parts[18].toInt() +
+        parts[23].toLong() + (parts[2] == "T" ? 1 : 0);
+    return true;
+}
+
+} // namespace baseline
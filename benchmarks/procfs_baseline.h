@@ -0,0 +1,30 @@
+#ifndef PROCFS_BASELINE_H
+#define PROCFS_BASELINE_H
+
+#include <cstddef>
+
+/**
+ * @brief The per-process /proc readers LuminaTask used before procfs.h
+ *
+ * One QString path, QFile, QTextStream and QStringList::split per file and
+ * field, as getAllProcesses() did for every process. Kept only so
+ * bench_procfs can compare against it; the interface is Qt-free so the
+ * benchmark driver is too.
+ */
+namespace baseline {
+
+/**
+ * @brief Read name, memory, CPU, state and priority of one process the old way
+ * @return false if the process no longer exists
+ */
+bool readProcess(int pid);
+
+/**
+ * @brief Tokenize a /proc/[PID]/stat line the old way and read the fields the scan used
+ * @return false if the line has too few fields
+ */
+bool parseStat(const char* data, std::size_t length);
+
+} // namespace baseline
+
+#endif // PROCFS_BASELINE_H
@@ -0,0 +1,85 @@
+#ifndef CPUUSAGE_H
+#define CPUUSAGE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "procfs.h"
+
+namespace procfs {
+
+/**
+ * @brief How one CPU (or all of them) spent an interval, in percent of that interval
+ */
+struct CpuUsage {
+    double user = 0.0;
+    double nice = 0.0;
+    double system = 0.0;
+    double idle = 0.0;
+    double iowait = 0.0;
+    double irq = 0.0;
+    double softirq = 0.0;
+    double steal = 0.0;  // Taken by the hypervisor for other guests
+
+    /**
+     * @brief Share of the interval the CPU was running something, steal included
+     */
+    [[nodiscard]] double busy() const { return user + nice + system + irq + softirq + steal; }
+};
+
+/**
+ * @brief System-wide and per-core CPU usage over one scan interval
+ */
+struct SystemCpuUsage {
+    bool valid = false;  // False until two samples of /proc/stat have been taken
+    CpuUsage total;  // Averaged over all online CPUs
+    std::vector<CpuUsage> cores;  // Indexed by CPU number; offline CPUs are all zero
+};
+
+/**
+ * @brief Turns successive reads of /proc/stat into per-interval CPU usage
+ *
+ * One read per sample() into a buffer sized for the machine's CPU count;
+ * the previous counters are kept so each sample yields the usage since the
+ * last one. Not thread-safe; the scan thread owns it.
+ */
+class CpuUsageCollector {
+public:
+    CpuUsageCollector();
+
+    /**
+     * @brief Read /proc/stat and compute usage since the previous sample
+     * @return false if /proc/stat could not be read; usage() is then unchanged
+     */
+    bool sample();
+
+    [[nodiscard]] const SystemCpuUsage& usage() const { return m_usage; }
+
+    /**
+     * @brief Raw aggregate counters of the last successful sample
+     */
+    [[nodiscard]] const CpuTimes& totalTimes() const { return m_total; }
+
+    /**
+     * @brief Number of CPUs that reported counters in the last sample, at least 1
+     */
+    [[nodiscard]] int onlineCoreCount() const { return m_onlineCoreCount; }
+
+private:
+    static CpuUsage usageBetween_(const CpuTimes& previous, const CpuTimes& current);
+
+    std::vector<char> m_buffer;
+    CpuTimes m_total;
+    CpuTimes m_previousTotal;
+    std::vector<CpuTimes> m_cores;
+    std::vector<CpuTimes> m_previousCores;
+    bool m_hasPrevious = false;
+    int m_onlineCoreCount = 1;
+    SystemCpuUsage m_usage;
+
+    static constexpr std::size_t BYTES_PER_CPU_LINE = 256;  // Ten 20-digit counters and a label fit
+};
+
+} // namespace procfs
+
+#endif // CPUUSAGE_H
@@ -8,14 +8,19 @@
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QLabel>
+#include <QDoubleSpinBox>
+#include <QComboBox>
 #include <QTimer>
 #include <QMessageBox>
 #include <QAction>
 #include <QMenu>
 #include <QContextMenuEvent>
+#include <QHash>
 #include <memory>
 
 #include "processmanager.h"
+#include "processtree.h"
+#include "processtreemodel.h"
 
 /**
  * @brief MainWindow class provides the GUI for the LuminaTask system monitor
@@ -34,29 +39,69 @@ protected:
     void contextMenuEvent(QContextMenuEvent* event) override;
 
 private slots:
-    void onProcessesUpdated_(const QVector<ProcessInfo>& processes);
+    void onProcessesUpdated_(const ProcessSnapshotPtr& snapshot);
     void onProcessTerminated_(int pid, bool success);
     void onRefreshButtonClicked_();
     void onKillProcessAction_();
     void onKillGracefullyAction_();
     void onSuspendProcessAction_();
     void onResumeProcessAction_();
+    void onShowDetailsAction_();
+    void onHeaderContextMenuRequested_(const QPoint& pos);
+    void onTreeItemExpanded_(const QModelIndex& index);
+    void onTreeItemCollapsed_(const QModelIndex& index);
     void onAutoRefreshToggled_(bool enabled);
     void onFocusModeToggled_(bool enabled);
+    void onCpuBudgetChanged_(double percentOfCore);
+    void onRefreshIntervalChanged_(int intervalMs);
+    void onLayoutChanged_(int index);
     void onMemoryLeakDetected_(int pid, const QString& processName, double growthMB);
 
 private:
+    /**
+     * @brief How processes are arranged in the tree view
+     */
+    enum class TreeLayout {
+        ByName,   // One top-level row per process name
+        ByParent  // Processes under the process that started them
+    };
+
+    /**
+     * @brief Processes sharing a name, as slots of the snapshot's process table
+     */
+    struct ProcessGroup {
+        QString name;
+        QVector<ProcessTable::Slot> members;
+        double totalMemory = 0.0;
+        double totalCpu = 0.0;
+    };
+
     // UI setup methods
     void setupUI_();
     void setupTreeView_();
     void setupToolbar_();
     void setupStatusBar_();
     void setupContextMenu_();
+    void setupColumnMenu_();
+
+    // Column visibility drives what the process manager collects
+    void setColumnVisible_(int column, bool visible);
+    void updateFieldMask_();
 
     // Table management
-    void updateProcessTree_(const QVector<ProcessInfo>& processes);
+    void updateProcessTree_(const ProcessSnapshot& snapshot);
+    void addGroupRows_(const ProcessSnapshot& snapshot, QVector<QStandardItem*>& expandedProcessItems);
+    void addParentTreeRows_(const ProcessSnapshot& snapshot, QVector<QStandardItem*>& expandedProcessItems);
+    QList<QStandardItem*> createProcessRow_(const ProcessSnapshot& snapshot, ProcessTable::Slot slot);
+    void attachThreads_(QStandardItem* item, ProcessTable::Slot slot, const ProcessSnapshot& snapshot,
+                        QVector<QStandardItem*>& expandedProcessItems);
+    void updateCpuUsageLabel_(const procfs::SystemCpuUsage& cpu);
+    void appendThreadRows_(QStandardItem* processItem, const std::vector<ThreadInfo>& threads);
+    [[nodiscard]] int processRowPID_(const QModelIndex& index) const;
     void clearProcessTree_();
     [[nodiscard]] int getSelectedProcessPID_() const;
+    [[nodiscard]] ProcessTable::Handle displayedHandle_(int pid) const;
+    [[nodiscard]] bool confirmStillRunning_(int pid, ProcessTable::Handle handle);
 
     // UI helper methods
     void showErrorMessage_(const QString& title, const QString& message);
@@ -68,12 +113,16 @@ private:
 
     // Core UI components
     std::unique_ptr<QTreeView> m_processTreeView;
-    std::unique_ptr<QStandardItemModel> m_processModel;
+    std::unique_ptr<ProcessTreeModel> m_processModel;
     std::unique_ptr<QPushButton> m_refreshButton;
     std::unique_ptr<QPushButton> m_autoRefreshButton;
     std::unique_ptr<QPushButton> m_focusModeButton;
+    std::unique_ptr<QDoubleSpinBox> m_cpuBudgetSpinBox;
+    std::unique_ptr<QComboBox> m_layoutComboBox;
     std::unique_ptr<QLabel> m_statusLabel;
     std::unique_ptr<QLabel> m_processCountLabel;
+    std::unique_ptr<QLabel> m_refreshIntervalLabel;
+    std::unique_ptr<QLabel> m_cpuUsageLabel;
 
     // Process manager
     std::unique_ptr<ProcessManager> m_processManager;
@@ -84,6 +133,21 @@ private:
     std::unique_ptr<QAction> m_killGracefullyAction;
     std::unique_ptr<QAction> m_suspendProcessAction;
     std::unique_ptr<QAction> m_resumeProcessAction;
+    std::unique_ptr<QAction> m_showDetailsAction;
+
+    // Header menu for showing and hiding columns
+    std::unique_ptr<QMenu> m_columnMenu;
+
+    // Snapshot the tree currently shows
+    ProcessSnapshotPtr m_displayedSnapshot;
+
+    // Processes whose threads are shown, by PID. Handles tell a process that
+    // exited apart from a new one that was given its PID.
+    QHash<int, ProcessTable::Handle> m_expandedProcesses;
+
+    // Tree layout, and the hierarchy it is built from in ByParent mode
+    TreeLayout m_treeLayout = TreeLayout::ByName;
+    ProcessTree m_processHierarchy;
 
     // Constants
     static constexpr int TREE_COLUMN_NAME = 0;
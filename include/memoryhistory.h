@@ -0,0 +1,57 @@
+#ifndef MEMORYHISTORY_H
+#define MEMORYHISTORY_H
+
+#include <QPair>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief Fixed-capacity ring buffer of (timestamp, memory) samples for one process
+ *
+ * Appending and trimming the oldest samples are O(1) and never allocate;
+ * once full, each append overwrites the oldest sample.
+ */
+class MemoryHistory {
+public:
+    using Sample = QPair<qint64, double>;  // timestamp in ms, memory in MB
+
+    /**
+     * @brief Add a sample, dropping the oldest one if the buffer is full
+     */
+    void append(qint64 timestamp, double memoryMB) {
+        m_samples[(m_first + m_size) % CAPACITY] = qMakePair(timestamp, memoryMB);
+        if (m_size < CAPACITY) {
+            ++m_size;
+        } else {
+            m_first = (m_first + 1) % CAPACITY;
+        }
+    }
+
+    /**
+     * @brief Drop samples taken before a cutoff time
+     */
+    void removeOlderThan(qint64 cutoff) {
+        while (m_size > 0 && m_samples[m_first].first < cutoff) {
+            m_first = (m_first + 1) % CAPACITY;
+            --m_size;
+        }
+    }
+
+    [[nodiscard]] int size() const { return m_size; }
+
+    /**
+     * @brief Sample by age, 0 being the oldest
+     */
+    [[nodiscard]] const Sample& at(int index) const { return m_samples[(m_first + index) % CAPACITY]; }
+    [[nodiscard]] const Sample& first() const { return at(0); }
+    [[nodiscard]] const Sample& last() const { return at(m_size - 1); }
+
+    static constexpr int CAPACITY = 30;  // 1 minute of history at 2-second intervals
+
+private:
+    std::array<Sample, CAPACITY> m_samples{};
+    int m_first = 0;
+    int m_size = 0;
+};
+
+#endif // MEMORYHISTORY_H
@@ -2,18 +2,35 @@
 #define PROCESSMANAGER_H
 
 #include <QObject>
+#include <QMutex>
 #include <QString>
 #include <QVector>
 #include <QTimer>
-#include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QPair>
+#include <atomic>
+#include <functional>
 #include <optional>
 #include <memory>
 #include <chrono>
 #include <csignal>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "processsnapshot.h"
+#include "processtable.h"
+#include "cpuusage.h"
+#include "memoryhistory.h"
+#include "procfs.h"
+#include "refreshcoordinator.h"
+#include "uringreader.h"
 
 // Forward declarations
 class QStandardItemModel;
+class QThread;
+class QThreadPool;
 
 /**
  * @brief Enumeration for process termination methods
@@ -24,31 +41,27 @@ enum class TerminationMethod {
 };
 
 /**
- * @brief Enumeration for process suspension states
+ * @brief Enumeration for the way /proc is read during a scan
  */
-enum class ProcessState {
-    Running,   // Normal running state
-    Suspended  // Suspended with SIGSTOP
+enum class ScanBackend {
+    Synchronous,  // open/pread/close per file, sharded across the scan pool
+    IoUring       // Batched openat/read/close submissions on an io_uring
 };
 
 /**
- * @brief Structure containing process information
+ * @brief Per-process metrics a scan can collect
+ *
+ * Fields outside the active mask are left at their ProcessInfo defaults and
+ * cost no /proc reads or bookkeeping.
  */
-struct ProcessInfo {
-    int pid;
-    QString name;
-    double memoryMB;
-    double cpuPercent;
-    ProcessState state;
-    QVector<QPair<qint64, double>> memoryHistory;  // timestamp, memory pairs
-    bool isMemoryLeech;
-    int priority;
-
-    ProcessInfo() : pid(0), memoryMB(0.0), cpuPercent(0.0), state(ProcessState::Running), 
-                   isMemoryLeech(false), priority(0) {}
-    ProcessInfo(int p, const QString& n, double mem, double cpu = 0.0, ProcessState s = ProcessState::Running)
-        : pid(p), name(n), memoryMB(mem), cpuPercent(cpu), state(s), isMemoryLeech(false), priority(0) {}
+enum class ProcessField : unsigned {
+    Memory   = 1u << 0,  // Resident memory, history and leak detection
+    Cpu      = 1u << 1,  // CPU usage over the last interval; needs /proc/stat once per scan
+    State    = 1u << 2,
+    Priority = 1u << 3
 };
+Q_DECLARE_FLAGS(ProcessFields, ProcessField)
+Q_DECLARE_OPERATORS_FOR_FLAGS(ProcessFields)
 
 /**
  * @brief ProcessManager class handles all process-related operations
@@ -63,9 +76,15 @@ public:
     explicit ProcessManager(QObject* parent = nullptr);
     ~ProcessManager() override;
 
-    // Process discovery and information
-    [[nodiscard]] QVector<ProcessInfo> getAllProcesses();
+    // Process discovery and information; scans run on a dedicated thread
+    void requestRefresh();
+    void requestProcessRefresh(const std::vector<int>& pids);
+    void watchThreads(int pid, bool watch);
+    [[nodiscard]] ProcessSnapshotPtr snapshot() const { return std::atomic_load(&m_snapshot); }
     [[nodiscard]] std::optional<ProcessInfo> getProcessInfo(int processID);
+    [[nodiscard]] std::optional<QString> getProcessDetails(int processID) const;
+    [[nodiscard]] bool isProcessRunning(const ProcessKey& key) const;
+    void scanStatContents(std::vector<int> pids, std::vector<std::string> stats);  // Benchmarks only
 
     // Process management
     [[nodiscard]] bool terminateProcess(int processID, TerminationMethod method = TerminationMethod::Graceful);
@@ -74,58 +93,203 @@ public:
     [[nodiscard]] bool setPriority(int processID, int priority);
     
     // Memory leak detection
-    void updateMemoryHistory_(ProcessInfo& processInfo);
-    [[nodiscard]] bool detectMemoryLeak_(const ProcessInfo& processInfo) const;
+    const MemoryHistory& updateMemoryHistory_(const ProcessKey& key, double memoryMB);
+    [[nodiscard]] bool detectMemoryLeak_(const MemoryHistory& history) const;
     
     // Focus mode (Game mode)
     void enableFocusMode(bool enabled);
     [[nodiscard]] bool isFocusModeEnabled() const { return m_focusModeEnabled; }
-    void optimizeForFocusedApp_();
+    void optimizeForFocusedApp_(const ProcessSnapshot& snapshot);
+
+    // Parallel scanning
+    void setScanThreadCount(int threadCount);
+    [[nodiscard]] int scanThreadCount() const { return m_scanThreadCount; }
+    [[nodiscard]] bool setScanBackend(ScanBackend backend);
+    [[nodiscard]] ScanBackend scanBackend() const {
+        return m_uringActive ? ScanBackend::IoUring : ScanBackend::Synchronous;
+    }
+
+    // Collection mask: only these fields (plus what active detectors need) are read
+    void setFieldMask(ProcessFields fields);
+    [[nodiscard]] ProcessFields fieldMask() const;
+
+    // CPU% is per interval: 100% is one busy core, unless normalized over all cores
+    void setCpuNormalizedPerCore(bool normalized) { m_cpuNormalizedPerCore = normalized; }
+    [[nodiscard]] bool isCpuNormalizedPerCore() const { return m_cpuNormalizedPerCore; }
+
+    // Tiered sampling: idle processes are re-read less often
+    void setColdSampleInterval(int ticks);
+    [[nodiscard]] int coldSampleInterval() const { return m_coldSampleInterval; }
 
     // Real-time updates
     void startPeriodicRefresh(std::chrono::milliseconds interval = std::chrono::milliseconds{2000});
     void stopPeriodicRefresh();
 
+    // CPU budget: the refresh interval stretches so the monitor stays within a share of one core
+    void setCpuBudget(double percentOfCore);
+    [[nodiscard]] double cpuBudget() const { return m_cpuBudgetPercent; }
+    [[nodiscard]] std::chrono::milliseconds refreshInterval() const {
+        return std::chrono::milliseconds{m_effectiveIntervalMs.load()};
+    }
+
 signals:
-    void processesUpdated(const QVector<ProcessInfo>& processes);
+    void processesUpdated(const ProcessSnapshotPtr& snapshot);
     void processTerminated(int pid, bool success);
     void memoryLeakDetected(int pid, const QString& processName, double growthMB);
     void focusModeChanged(bool enabled);
+    void refreshIntervalChanged(int intervalMs);
 
 private slots:
     void refreshProcessList_();
 
 private:
+    /**
+     * @brief Raw per-process data gathered by the parallel phase of a scan
+     */
+    struct ProcessSample {
+        bool valid = false;
+        bool fresh = false;  // Read this tick, as opposed to carried over by the sampling scheduler
+        procfs::ProcessStat stat;  // The name is its comm field
+    };
+
+    /**
+     * @brief CPU counters of a process at its previous sample
+     */
+    struct CpuSample {
+        unsigned long long processTicks = 0;  // utime + stime
+        unsigned long long systemTicks = 0;  // Total of the aggregate /proc/stat line at the time
+    };
+
+    /**
+     * @brief Sampling tier of a process, by recent CPU and memory activity
+     */
+    enum class SamplingTier {
+        Hot,   // Changed at its last sample, read every tick
+        Warm,  // Recently idle, read every m_coldSampleInterval / 2 ticks
+        Cold   // Idle for COLD_AFTER_IDLE_SAMPLES samples, read every m_coldSampleInterval ticks
+    };
+
+    /**
+     * @brief Per-PID sampling scheduler state
+     */
+    struct SamplingState {
+        SamplingTier tier = SamplingTier::Hot;
+        int idleSamples = 0;
+        bool forceSample = false;  // Read on the next tick regardless of tier
+        quint64 lastSeenTick = 0;
+        ProcessSample lastSample;
+    };
+
     // Helper methods
     [[nodiscard]] bool isValidProcessID_(int pid) const;
-    [[nodiscard]] QString readProcessName_(int pid) const;
-    [[nodiscard]] double readProcessMemory_(int pid) const;
-    [[nodiscard]] double readProcessCpu_(int pid) const;
-    [[nodiscard]] ProcessState readProcessState_(int pid) const;
-    [[nodiscard]] int readProcessPriority_(int pid) const;
+    [[nodiscard]] double readProcessMemory_(const procfs::ProcessStat& stat) const;
+    [[nodiscard]] std::optional<procfs::ProcessStat> readProcessStat_(int pid);
+    [[nodiscard]] double readProcessCpu_(const ProcessKey& key, const procfs::ProcessStat& stat);
+    [[nodiscard]] double cpuPercentSince_(CpuSample& previous, unsigned long long ticks) const;
+    [[nodiscard]] ProcessState readProcessState_(const procfs::ProcessStat& stat) const;
+    [[nodiscard]] int readProcessPriority_(const procfs::ProcessStat& stat) const;
+    void readSystemCpuTicks_();
+    void runOnScanThread_(std::function<void()> function);
+    void scanAndPublish_();
+    void rereadProcesses_();
+    void readWatchedThreads_();
+    [[nodiscard]] bool scan_();
+    void beginScan_();
+    void applySamples_();
+    void publishSnapshot_();
+    void applyPendingRequests_();
+    void resizeScanShards_(int threadCount);
+    void restoreFocusAdjustedPriorities_();
+    void recordScanCost_(double cpuTimeMs);
+    [[nodiscard]] int budgetedInterval_() const;
+    void applyRefreshInterval_(int intervalMs);
+    [[nodiscard]] ProcessFields requiredFields_() const;
+    [[nodiscard]] procfs::ProcessFileCache& fileCacheFor_(int pid);
+    void sampleProcess_(int pid, ProcessSample& sample);
+    void sampleAllProcesses_();
+    void sampleDueProcessesSharded_();
+    [[nodiscard]] bool sampleAllProcessesUring_();
+    [[nodiscard]] bool isSampleDue_(int pid, ProcessSample& sample);
+    void updateSamplingTier_(int pid, const ProcessSample& sample);
+    void pruneSamplingStates_();
+    void pruneExitedProcesses_();
+    void forceSample_(int pid);
+    void updateProcessRow_(ProcessTable::Slot slot, const ProcessSample& sample);
     [[nodiscard]] bool canKillProcess_(int pid) const;
-    [[nodiscard]] int getFocusedWindowPID_() const;
-    [[nodiscard]] bool isBackgroundProcess_(const ProcessInfo& processInfo) const;
+    [[nodiscard]] int getFocusedWindowPID_(const ProcessTable& table) const;
+    [[nodiscard]] bool isBackgroundProcess_(const ProcessTable& table, ProcessTable::Slot slot) const;
 
     // Member variables
     std::unique_ptr<QTimer> m_refreshTimer;
-    mutable QVector<ProcessInfo> m_cachedProcesses;
-    bool m_focusModeEnabled;
-    QMap<int, QVector<QPair<qint64, double>>> m_processMemoryHistory;
+    std::atomic<int> m_baseIntervalMs{REFRESH_INTERVAL_MS};  // Requested interval; the budget never goes below it
+    std::atomic<int> m_effectiveIntervalMs{REFRESH_INTERVAL_MS};  // Interval the timer runs at
+    std::atomic<double> m_cpuBudgetPercent{0.0};  // Share of one core; 0 disables budgeting
+    std::atomic<double> m_scanCostMs{0.0};  // Smoothed process CPU time per scan
+    procfs::FileDescriptor m_procDirFd;  // /proc, base for all per-process openat() calls
+    long m_pageSize = 4096;
+    std::atomic<int> m_pidMax{procfs::PID_MAX_LIMIT};  // kernel.pid_max; valid PIDs are below it
+
+    // Everything below up to m_snapshot belongs to the scan thread, unless noted
+    std::unique_ptr<QThread> m_scanThread;
+    std::unique_ptr<QObject> m_scanContext;  // Lives on m_scanThread; target of runOnScanThread_()
+    RefreshCoordinator m_refreshCoordinator;  // Any thread
+    std::unique_ptr<QThreadPool> m_scanPool;
+    std::atomic<int> m_scanThreadCount{1};  // Mirrors m_fileCaches.size() for other threads
+    // One descriptor cache per scan shard; PID p always lives in shard p % size()
+    std::vector<std::unique_ptr<procfs::ProcessFileCache>> m_fileCaches;
+    std::vector<std::vector<int>> m_shardIndices;  // Indices into m_processIds, per shard
+    std::vector<int> m_processIds;  // Sorted PIDs of the current scan, capacity reused
+    std::vector<ProcessSample> m_samples;  // Parallel to m_processIds
+    std::vector<int> m_dueIndices;  // Indices into m_processIds that are read this tick
+    // Keyed by bare PID since the schedule is decided before stat is read;
+    // isSampleDue_() checks the cached descriptor before reusing a sample
+    std::unordered_map<int, SamplingState> m_samplingStates;
+    quint64 m_scanTick = 0;
+    std::atomic<int> m_coldSampleInterval{DEFAULT_COLD_SAMPLE_INTERVAL};  // Any thread
+    ProcessFields m_requestedFields = ALL_PROCESS_FIELDS;  // m_fieldMask as of the current scan
+    ProcessFields m_activeFields = ALL_PROCESS_FIELDS;  // Effective mask of the current scan
+    std::unique_ptr<procfs::UringReader> m_uringReader;  // Set only when the io_uring backend is active
+    std::atomic<bool> m_uringActive{false};  // Backend selected by the caller; any thread
+    std::vector<procfs::UringReader::Request> m_uringRequests;
+    std::vector<char> m_uringBuffers;
+    ProcessTable m_processTable;  // Working table of the scan, copied into each snapshot
+    ProcessSnapshotPtr m_snapshot;  // Latest published scan; accessed with std::atomic_load/store
+    quint64 m_snapshotSequence = 0;
+    std::atomic<bool> m_focusModeEnabled;
+    QHash<ProcessKey, MemoryHistory> m_processMemoryHistory;  // Live processes only; swept after every scan
+    QHash<ProcessKey, CpuSample> m_cpuSamples;  // Baselines for interval CPU%; swept after every scan
+    unsigned long long m_systemCpuTicks = 0;  // Aggregate /proc/stat total as of the current scan
+    int m_cpuCount = 1;  // Online CPUs, as counted by m_cpuCollector
+    procfs::CpuUsageCollector m_cpuCollector;  // Reads /proc/stat once per full scan
+    QSet<int> m_threadWatchPids;  // Processes whose threads are read with every scan
+    std::unordered_map<int, std::vector<ThreadInfo>> m_threads;  // Latest threads of m_threadWatchPids
+    QHash<ProcessKey, CpuSample> m_threadCpuSamples;  // Keyed by (TID, start time); only watched threads
+    std::vector<int> m_taskIds;  // Scratch space for readWatchedThreads_()
+    std::vector<procfs::ThreadStat> m_threadStats;
+    std::atomic<bool> m_cpuNormalizedPerCore{false};  // Any thread
+    QSet<ProcessKey> m_focusAdjustedProcesses;  // Priorities changed by focus mode, restored when it is disabled
+
+    // Requests from other threads, applied by the scan thread when the next scan starts
+    mutable QMutex m_requestMutex;
+    ProcessFields m_fieldMask = ALL_PROCESS_FIELDS;  // Requested by the caller
+    std::vector<int> m_pendingSamples;  // PIDs to re-read regardless of their sampling tier
+    bool m_forceSampleAll = false;
 
     // Constants
-    static constexpr int MAX_PROCESS_COUNT = 10000;
     static constexpr int REFRESH_INTERVAL_MS = 2000;
+    static constexpr int MAX_REFRESH_INTERVAL_MS = 30000;  // Budgeting never stalls updates longer than this
+    static constexpr int REFRESH_INTERVAL_STEP_MS = 100;  // Budgeted intervals are rounded up to this
+    static constexpr double SCAN_COST_SMOOTHING = 0.25;  // Weight of the newest scan in m_scanCostMs
     static constexpr double MEMORY_LEAK_THRESHOLD_MB = 100.0;
     static constexpr qint64 MEMORY_LEAK_TIME_WINDOW_MS = 60000;  // 1 minute
-    static constexpr int HISTORY_MAX_ENTRIES = 30;  // Keep 1 minute of history at 2-second intervals
-};
-
-// Custom exception for process operations
-class ProcessException : public std::runtime_error {
-public:
-    explicit ProcessException(const QString& message)
-        : std::runtime_error(message.toStdString()) {}
+    // Further capped at idealThreadCount(): threads beyond the CPUs only slow a scan down (bench_scan_threads)
+    static constexpr int DEFAULT_MAX_SCAN_THREADS = 8;
+    // About 1 ms of reads per thread, well above the cost of handing a shard to the pool
+    static constexpr int MIN_PROCESSES_PER_SCAN_THREAD = 256;
+    static constexpr int DEFAULT_COLD_SAMPLE_INTERVAL = 5;  // Idle processes are re-read every 10 seconds
+    static constexpr int COLD_AFTER_IDLE_SAMPLES = 3;
+    static constexpr ProcessFields ALL_PROCESS_FIELDS = ProcessField::Memory | ProcessField::Cpu |
+        ProcessField::State | ProcessField::Priority;
 };
 
 #endif // PROCESSMANAGER_H
\ No newline at end of file
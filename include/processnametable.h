@@ -0,0 +1,89 @@
+#ifndef PROCESSNAMETABLE_H
+#define PROCESSNAMETABLE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Interned process names with small integer IDs
+ *
+ * Process names are massively repetitive (hundreds of chrome, kworker/...),
+ * so each distinct name is stored once and rows refer to it by NameId.
+ * Grouping and equality checks then compare integers, and a QString is
+ * only built the first time a name is seen.
+ *
+ * IDs are reference counted by their users. Names that are no longer used
+ * stay interned, so short-lived processes that come back every tick (sh,
+ * cron jobs) do not re-allocate; they are only dropped and their IDs
+ * recycled once they outnumber the names in use.
+ *
+ * The ID-to-name list is held by shared pointer and never modified while a
+ * copy shares it: a tick that adds or drops names first replaces the list,
+ * every other tick leaves it alone. A copy (e.g. in a published snapshot)
+ * therefore costs one reference count and stays valid however the original
+ * changes. Copies are read-only: they resolve names but hold none of the
+ * interning state, and acquire()/release() must only be called on the
+ * table that was default-constructed.
+ */
+class ProcessNameTable {
+public:
+    using NameId = std::uint32_t;
+
+    ProcessNameTable();
+    ProcessNameTable(const ProcessNameTable& other);
+    ProcessNameTable& operator=(const ProcessNameTable& other);
+    ProcessNameTable(ProcessNameTable&&) noexcept = default;
+    ProcessNameTable& operator=(ProcessNameTable&&) noexcept = default;
+
+    /**
+     * @brief Take a reference to a name, interning it if it is new
+     * @param data UTF-8 bytes of the name, without terminator
+     * @return ID of the name; NO_NAME for an empty name
+     */
+    [[nodiscard]] NameId acquire(const char* data, std::size_t length);
+
+    /**
+     * @brief Drop a reference taken with acquire()
+     */
+    void release(NameId id);
+
+    /**
+     * @brief Whether an ID stands for exactly these UTF-8 bytes
+     */
+    [[nodiscard]] bool equals(NameId id, const char* data, std::size_t length) const;
+
+    [[nodiscard]] const QString& name(NameId id) const { return (*m_names)[id]; }
+
+    /**
+     * @brief One more than the largest ID in use, for arrays indexed by ID
+     */
+    [[nodiscard]] std::size_t idCount() const { return m_names->size(); }
+
+    /**
+     * @brief Forget unused names once they outnumber the names in use
+     */
+    void collectUnused();
+
+    static constexpr NameId NO_NAME = 0;  // The empty name; never released
+
+private:
+    std::vector<QString>& writableNames_();
+
+    std::shared_ptr<std::vector<QString>> m_names;  // Indexed by ID; shared with copies
+
+    // Interning state, only in the table that interns
+    std::vector<QByteArray> m_utf8Names;  // Indexed by ID; null for recycled IDs
+    QHash<QByteArray, NameId> m_ids;
+    std::vector<std::uint32_t> m_refCounts;
+    std::vector<NameId> m_freeIds;
+    std::size_t m_unusedCount = 0;  // Interned names with no references
+
+    static constexpr std::size_t MIN_UNUSED_BEFORE_COLLECT = 256;
+};
+
+#endif // PROCESSNAMETABLE_H
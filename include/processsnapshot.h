@@ -0,0 +1,58 @@
+#ifndef PROCESSSNAPSHOT_H
+#define PROCESSSNAPSHOT_H
+
+#include <QMetaType>
+#include <QtGlobal>
+#include <QString>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "cpuusage.h"
+#include "processtable.h"
+
+/**
+ * @brief One thread of a process whose threads are watched
+ */
+struct ThreadInfo {
+    int tid = 0;
+    QString name;
+    double cpuPercent = 0.0;  // Over the last interval, on the same scale as ProcessInfo::cpuPercent
+    ProcessState state = ProcessState::Running;
+    int processor = -1;  // CPU the thread last ran on
+};
+
+/**
+ * @brief Immutable result of one scan, shared by every consumer
+ *
+ * ProcessManager builds a snapshot once per scan and publishes it as a
+ * std::shared_ptr<const ProcessSnapshot>. The GUI, focus mode and detectors
+ * all hold the same object; nothing is copied per consumer, and a consumer
+ * that keeps its pointer sees a consistent table even while newer scans are
+ * published.
+ */
+struct ProcessSnapshot {
+    qint64 timestamp = 0;  // When the scan finished, in ms since the epoch
+    quint64 sequence = 0;  // Increases by one per published scan
+    ProcessTable table;  // Rows in PID order via liveSlots(); indexed by PID via find()
+    procfs::SystemCpuUsage cpu;  // System-wide and per-core usage since the previous scan
+    std::unordered_map<int, std::vector<ThreadInfo>> threads;  // By PID, only for processes whose threads are watched
+
+    /**
+     * @brief Row view of a process in this snapshot, without memory history
+     */
+    [[nodiscard]] std::optional<ProcessInfo> find(int pid) const {
+        const ProcessTable::Slot slot = table.find(pid);
+        if (slot == ProcessTable::INVALID_SLOT) {
+            return std::nullopt;
+        }
+        return table.info(slot);
+    }
+};
+
+using ProcessSnapshotPtr = std::shared_ptr<const ProcessSnapshot>;
+
+Q_DECLARE_METATYPE(ProcessSnapshotPtr)
+
+#endif // PROCESSSNAPSHOT_H
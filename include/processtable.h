@@ -0,0 +1,206 @@
+#ifndef PROCESSTABLE_H
+#define PROCESSTABLE_H
+
+#include <QString>
+#include <QHash>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "processnametable.h"
+
+/**
+ * @brief Enumeration for process suspension states
+ */
+enum class ProcessState {
+    Running,   // Normal running state
+    Suspended  // Suspended with SIGSTOP
+};
+
+/**
+ * @brief Identity of a process that survives PID reuse
+ *
+ * The kernel may hand a PID to a new process as soon as the old one is
+ * reaped, but the start time (stat field 22, in clock ticks after boot)
+ * tells the two apart.
+ */
+struct ProcessKey {
+    int pid = 0;
+    unsigned long long startTime = 0;
+
+    bool operator==(const ProcessKey& other) const { return pid == other.pid && startTime == other.startTime; }
+    bool operator!=(const ProcessKey& other) const { return !(*this == other); }
+};
+
+inline size_t qHash(const ProcessKey& key, size_t seed = 0) noexcept {
+    return qHashMulti(seed, key.pid, key.startTime);
+}
+
+/**
+ * @brief Structure containing process information
+ *
+ * A self-contained row view of one process. The canonical store is the
+ * columnar ProcessTable; ProcessInfo is what existing callers and signals
+ * consume.
+ */
+struct ProcessInfo {
+    int pid;
+    unsigned long long startTime;  // With pid, the process's ProcessKey
+    QString name;
+    double memoryMB;
+    double cpuPercent;
+    ProcessState state;
+    bool isMemoryLeech;
+    int priority;
+
+    ProcessInfo() : pid(0), startTime(0), memoryMB(0.0), cpuPercent(0.0), state(ProcessState::Running),
+                   isMemoryLeech(false), priority(0) {}
+    ProcessInfo(int p, const QString& n, double mem, double cpu = 0.0, ProcessState s = ProcessState::Running)
+        : pid(p), startTime(0), name(n), memoryMB(mem), cpuPercent(cpu), state(s),
+          isMemoryLeech(false), priority(0) {}
+};
+
+/**
+ * @brief Columnar (structure-of-arrays) store of the processes seen by the last scan
+ *
+ * Each process occupies a slot and every metric is a parallel array indexed
+ * by slot, so sorting, filtering and aggregating only touch the columns they
+ * need. Slots of exited processes are recycled; their generation counter is
+ * bumped so that a Handle to the old process can be told apart from the new
+ * occupant. A PID that comes back with a different start time is a new
+ * process and gets a fresh row the same way.
+ *
+ * Updates are a mark-and-sweep cycle: beginUpdate(), upsert() for every live
+ * process in ascending PID order, then endUpdate() frees every slot not upserted.
+ * The PID order doubles as the index: upsert() merges against the previous
+ * order and find() binary-searches it, so the table holds no hash nodes and
+ * copying it (e.g. into a snapshot) is a handful of flat vector copies.
+ *
+ * Names are interned in a ProcessNameTable; the name column holds IDs, so
+ * rows with the same name share one string and can be grouped by integer.
+ */
+class ProcessTable {
+public:
+    using Slot = std::uint32_t;
+    using NameId = ProcessNameTable::NameId;
+
+    /**
+     * @brief Reference to a process row that detects slot reuse
+     */
+    struct Handle {
+        Slot slot = INVALID_SLOT;
+        std::uint32_t generation = 0;
+
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Start a scan; rows not upserted before endUpdate() are removed
+     */
+    void beginUpdate();
+
+    /**
+     * @brief Mark a process as live in the current scan, allocating a slot if it is new
+     * @param key Process identity; PIDs must be upserted in ascending order
+     * @return Slot of the process; its columns are reset if the PID was reused
+     */
+    Slot upsert(const ProcessKey& key);
+
+    /**
+     * @brief Free the slots of all processes that were not upserted since beginUpdate()
+     */
+    void endUpdate();
+
+    /**
+     * @brief Remove one row outside of an update cycle, e.g. for a process seen to exit
+     */
+    void remove(Slot slot);
+
+    /**
+     * @brief Live slots in ascending PID order
+     */
+    [[nodiscard]] const std::vector<Slot>& liveSlots() const { return m_order; }
+    [[nodiscard]] std::size_t size() const { return m_order.size(); }
+
+    /**
+     * @brief One more than the largest slot in use, for arrays indexed by slot
+     */
+    [[nodiscard]] std::size_t slotCount() const { return m_pids.size(); }
+
+    /**
+     * @brief Slot of a live PID, or INVALID_SLOT; not valid between beginUpdate() and endUpdate()
+     */
+    [[nodiscard]] Slot find(int pid) const;
+
+    /**
+     * @brief Whether the process with this exact identity is live
+     */
+    [[nodiscard]] bool contains(const ProcessKey& key) const;
+
+    [[nodiscard]] Handle handle(Slot slot) const { return {slot, m_generations[slot]}; }
+    [[nodiscard]] bool isValid(Handle handle) const;
+
+    // Column access
+    [[nodiscard]] int pid(Slot slot) const { return m_pids[slot]; }
+    [[nodiscard]] unsigned long long startTime(Slot slot) const { return m_startTimes[slot]; }
+    [[nodiscard]] int parentPid(Slot slot) const { return m_parentPids[slot]; }
+    [[nodiscard]] ProcessKey key(Slot slot) const { return {m_pids[slot], m_startTimes[slot]}; }
+    [[nodiscard]] NameId nameId(Slot slot) const { return m_nameIds[slot]; }
+    [[nodiscard]] const QString& name(Slot slot) const { return m_names.name(m_nameIds[slot]); }
+    [[nodiscard]] double memoryMB(Slot slot) const { return m_memoryMB[slot]; }
+    [[nodiscard]] double cpuPercent(Slot slot) const { return m_cpuPercent[slot]; }
+    [[nodiscard]] ProcessState state(Slot slot) const { return m_states[slot]; }
+    [[nodiscard]] int priority(Slot slot) const { return m_priorities[slot]; }
+    [[nodiscard]] bool isMemoryLeech(Slot slot) const { return m_memoryLeech[slot] != 0; }
+
+    /**
+     * @brief Set the name from UTF-8 bytes; a no-op if it is unchanged
+     */
+    void setName(Slot slot, const char* data, std::size_t length);
+    void setParentPid(Slot slot, int parentPid) { m_parentPids[slot] = parentPid; }
+    void setMemoryMB(Slot slot, double memoryMB) { m_memoryMB[slot] = memoryMB; }
+    void setCpuPercent(Slot slot, double cpuPercent) { m_cpuPercent[slot] = cpuPercent; }
+    void setState(Slot slot, ProcessState state) { m_states[slot] = state; }
+    void setPriority(Slot slot, int priority) { m_priorities[slot] = priority; }
+    void setMemoryLeech(Slot slot, bool leech) { m_memoryLeech[slot] = leech ? 1 : 0; }
+
+    /**
+     * @brief Row view of one process
+     */
+    [[nodiscard]] ProcessInfo info(Slot slot) const;
+
+    /**
+     * @brief Interned names the name column refers to
+     */
+    [[nodiscard]] const ProcessNameTable& names() const { return m_names; }
+
+    static constexpr Slot INVALID_SLOT = ~Slot{0};
+
+private:
+    Slot allocate_();
+    void resetRow_(Slot slot);
+    void clearName_(Slot slot);
+
+    // Columns, indexed by slot
+    std::vector<int> m_pids;  // 0 for free slots
+    std::vector<unsigned long long> m_startTimes;
+    std::vector<int> m_parentPids;
+    std::vector<NameId> m_nameIds;
+    std::vector<double> m_memoryMB;
+    std::vector<double> m_cpuPercent;
+    std::vector<ProcessState> m_states;
+    std::vector<int> m_priorities;
+    std::vector<std::uint8_t> m_memoryLeech;
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_seenEpochs;  // Mark of the last update that upserted the slot
+
+    std::vector<Slot> m_freeSlots;
+    std::vector<Slot> m_order;  // Live slots in PID order
+    std::vector<Slot> m_previousOrder;  // m_order of the last update, merged against by upsert()
+    std::size_t m_mergeCursor = 0;  // Position in m_previousOrder of the next PID to upsert
+    std::uint32_t m_epoch = 0;
+    ProcessNameTable m_names;
+};
+
+#endif // PROCESSTABLE_H
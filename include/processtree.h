@@ -0,0 +1,73 @@
+#ifndef PROCESSTREE_H
+#define PROCESSTREE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "processtable.h"
+#include "procfs.h"
+
+/**
+ * @brief Parent/child hierarchy of the processes in a ProcessTable
+ *
+ * Built from the ppid column in O(n): two counting-sort passes order the
+ * processes by parent PID, one merge with the PID-ordered table finds each
+ * parent, one pass links children, and one bottom-up pass over a pre-order
+ * traversal sums memory and CPU over every subtree. Processes
+ * whose parent is not in the table (PID 1, kthreadd, or orphans whose
+ * parent exited between reads) become roots.
+ *
+ * All arrays are indexed by table slot and stay valid until the next build().
+ */
+class ProcessTree {
+public:
+    using Slot = ProcessTable::Slot;
+
+    /**
+     * @brief Rebuild the hierarchy and subtree totals from a table
+     */
+    void build(const ProcessTable& table);
+
+    /**
+     * @brief Processes without a parent in the table, in PID order
+     */
+    [[nodiscard]] const std::vector<Slot>& roots() const { return m_roots; }
+
+    /**
+     * @brief Every process, parents before their children
+     */
+    [[nodiscard]] const std::vector<Slot>& preOrder() const { return m_preOrder; }
+
+    [[nodiscard]] Slot parent(Slot slot) const { return m_parents[slot]; }
+    [[nodiscard]] Slot firstChild(Slot slot) const { return m_firstChildren[slot]; }
+    [[nodiscard]] Slot nextSibling(Slot slot) const { return m_nextSiblings[slot]; }
+
+    // Totals over a process and all of its descendants
+    [[nodiscard]] double subtreeMemoryMB(Slot slot) const { return m_subtreeMemoryMB[slot]; }
+    [[nodiscard]] double subtreeCpuPercent(Slot slot) const { return m_subtreeCpuPercent[slot]; }
+    [[nodiscard]] int subtreeSize(Slot slot) const { return m_subtreeSizes[slot]; }
+
+private:
+    [[nodiscard]] static std::size_t parentKey_(const ProcessTable& table, Slot slot, int shift);
+
+    std::vector<Slot> m_parents;
+    std::vector<Slot> m_firstChildren;  // Children are linked in PID order
+    std::vector<Slot> m_nextSiblings;
+    std::vector<double> m_subtreeMemoryMB;
+    std::vector<double> m_subtreeCpuPercent;
+    std::vector<int> m_subtreeSizes;
+    std::vector<Slot> m_roots;
+    std::vector<Slot> m_preOrder;
+    std::vector<Slot> m_stack;  // Scratch space for the traversal
+    std::vector<Slot> m_byParent;  // Live slots ordered by parent PID, then PID
+    std::vector<Slot> m_sortScratch;
+    std::vector<std::size_t> m_bucketStarts;
+
+    // Two passes of 11 bits cover every PID below procfs::PID_MAX_LIMIT (2^22)
+    static constexpr int PARENT_PID_RADIX_BITS = 11;
+    static constexpr std::size_t PARENT_PID_RADIX = std::size_t{1} << PARENT_PID_RADIX_BITS;
+    static_assert((std::size_t{1} << (2 * PARENT_PID_RADIX_BITS)) >= static_cast<std::size_t>(procfs::PID_MAX_LIMIT),
+                  "two counting passes must cover every PID");
+};
+
+#endif // PROCESSTREE_H
@@ -0,0 +1,39 @@
+#ifndef PROCESSTREEMODEL_H
+#define PROCESSTREEMODEL_H
+
+#include <QMetaType>
+#include <QModelIndex>
+#include <QStandardItemModel>
+#include <QVariant>
+
+/**
+ * @brief Item model for the process tree with lazily populated thread rows
+ *
+ * Threads are only read for expanded rows, so most rows have no children
+ * yet but must still show an expand arrow. Rather than a placeholder child
+ * per row, an item whose expansion shows threads carries the PID in
+ * THREADS_PID_ROLE and hasChildren() reports it as expandable.
+ */
+class ProcessTreeModel : public QStandardItemModel {
+public:
+    using QStandardItemModel::QStandardItemModel;
+
+    [[nodiscard]] bool hasChildren(const QModelIndex& parent = QModelIndex()) const override {
+        if (parent.isValid() && parent.column() == 0 && threadsPID(parent) > 0) {
+            return true;
+        }
+        return QStandardItemModel::hasChildren(parent);
+    }
+
+    /**
+     * @brief PID whose threads are shown when this row is expanded, or -1
+     */
+    [[nodiscard]] int threadsPID(const QModelIndex& index) const {
+        const QVariant pid = data(index.siblingAtColumn(0), THREADS_PID_ROLE);
+        return pid.typeId() == QMetaType::Int ? pid.toInt() : -1;
+    }
+
+    static constexpr int THREADS_PID_ROLE = Qt::UserRole + 1;
+};
+
+#endif // PROCESSTREEMODEL_H
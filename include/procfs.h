@@ -0,0 +1,305 @@
+#ifndef PROCFS_H
+#define PROCFS_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @brief Allocation-free readers and tokenizers for /proc files
+ *
+ * Everything in this namespace works on caller-provided stack buffers and
+ * plain read() calls, so the per-process hot path of a scan never touches
+ * the heap. None of these functions depend on Qt.
+ */
+namespace procfs {
+
+// Large enough for any /proc/[PID]/stat line (comm is at most 64 bytes)
+constexpr std::size_t STAT_BUFFER_SIZE = 1024;
+// /proc/[PID]/status is typically 1-1.5 KiB
+constexpr std::size_t STATUS_BUFFER_SIZE = 4096;
+// Kernel worker names in the stat comm field are at most 64 bytes including NUL
+constexpr std::size_t COMM_MAX_LENGTH = 64;
+// PID_MAX_LIMIT on 64-bit kernels, the largest value kernel.pid_max accepts
+constexpr int PID_MAX_LIMIT = 4 * 1024 * 1024;
+
+/**
+ * @brief Fields parsed from a single read of /proc/[PID]/stat
+ *
+ * Field numbers refer to proc(5). The comm field is located by its enclosing
+ * parentheses rather than by whitespace, since it may itself contain spaces
+ * and parentheses.
+ */
+struct ProcessStat {
+    char comm[COMM_MAX_LENGTH];     // (2) executable name, NUL-terminated
+    char state;                     // (3) R, S, D, T, t, Z, ...
+    int ppid;                       // (4) parent PID
+    unsigned long long utime;       // (14) user time in clock ticks
+    unsigned long long stime;       // (15) system time in clock ticks
+    long priority;                  // (18) kernel scheduling priority
+    long nice;                      // (19) nice value
+    long numThreads;                // (20) number of threads
+    unsigned long long startTime;   // (22) start time in clock ticks after boot
+    long rssPages;                  // (24) resident set size in pages
+    int processor;                  // (39) CPU last executed on
+
+    ProcessStat() : comm{}, state('R'), ppid(0), utime(0), stime(0), priority(0), nice(0),
+                    numThreads(0), startTime(0), rssPages(0), processor(-1) {}
+};
+
+/**
+ * @brief Parsed /proc/[PID]/task/[TID]/stat of one thread
+ */
+struct ThreadStat {
+    int tid = 0;
+    ProcessStat stat;
+};
+
+/**
+ * @brief CPU time counters of one "cpu" line of /proc/stat, in USER_HZ ticks
+ *
+ * guest and guest_nice are already included in user and nice, so they are
+ * not tracked separately.
+ */
+struct CpuTimes {
+    unsigned long long user = 0;
+    unsigned long long nice = 0;
+    unsigned long long system = 0;
+    unsigned long long idle = 0;
+    unsigned long long iowait = 0;
+    unsigned long long irq = 0;
+    unsigned long long softirq = 0;
+    unsigned long long steal = 0;
+
+    [[nodiscard]] unsigned long long total() const {
+        return user + nice + system + idle + iowait + irq + softirq + steal;
+    }
+};
+
+/**
+ * @brief Owning wrapper around a file descriptor, closed on destruction
+ */
+class FileDescriptor {
+public:
+    FileDescriptor() noexcept : m_fd(-1) {}
+    explicit FileDescriptor(int fd) noexcept : m_fd(fd) {}
+    ~FileDescriptor();
+
+    FileDescriptor(FileDescriptor&& other) noexcept : m_fd(other.release()) {}
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept;
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    [[nodiscard]] int get() const noexcept { return m_fd; }
+    [[nodiscard]] bool isValid() const noexcept { return m_fd >= 0; }
+    [[nodiscard]] int release() noexcept { const int fd = m_fd; m_fd = -1; return fd; }
+    void reset(int fd = -1) noexcept;
+
+private:
+    int m_fd;
+};
+
+/**
+ * @brief Format a PID as a NUL-terminated decimal string without allocating
+ * @param buffer Destination, at least 12 bytes
+ * @return Pointer to the first digit inside buffer
+ */
+const char* formatPid(int pid, char* buffer, std::size_t capacity);
+
+/**
+ * @brief Open /proc/[PID] relative to an open /proc directory
+ * @param procDirFd File descriptor of /proc
+ * @return Directory descriptor, invalid if the process no longer exists
+ */
+[[nodiscard]] FileDescriptor openProcessDir(int procDirFd, int pid);
+
+/**
+ * @brief Enumerate process IDs in /proc with batched getdents64() calls
+ * @param procDirFd File descriptor of /proc; its offset is rewound first
+ * @param pids Output, cleared and filled in ascending order (capacity is reused)
+ * @return false if the directory could not be read
+ */
+bool listProcessIds(int procDirFd, std::vector<int>& pids);
+
+/**
+ * @brief Read /proc/[PID]/task/[TID]/stat for every thread of a process
+ * @param procDirFd File descriptor of /proc
+ * @param tids Scratch space for the thread IDs, capacity reused
+ * @param threads Output, cleared and filled in TID order; threads that exit while reading are skipped
+ * @return false if the process no longer exists
+ */
+bool readThreadStats(int procDirFd, int pid, std::vector<int>& tids, std::vector<ThreadStat>& threads);
+
+/**
+ * @brief Read a whole file relative to a directory descriptor with a single read()
+ * @param dirFd Directory descriptor, e.g. from openProcessDir()
+ * @param name File name relative to dirFd, e.g. "stat"
+ * @param buffer Destination buffer, NUL-terminated on success
+ * @param capacity Size of the destination buffer
+ * @return Number of bytes read, or -1 on error (errno is preserved)
+ */
+[[nodiscard]] ssize_t readFileAt(int dirFd, const char* name, char* buffer, std::size_t capacity);
+
+/**
+ * @brief Read a whole /proc file into a fixed buffer with a single read()
+ * @param path Absolute path of the file
+ * @param buffer Destination buffer, NUL-terminated on success
+ * @param capacity Size of the destination buffer
+ * @return Number of bytes read, or -1 on error (errno is preserved)
+ */
+[[nodiscard]] ssize_t readFile(const char* path, char* buffer, std::size_t capacity);
+
+/**
+ * @brief Read kernel.pid_max from /proc/sys/kernel/pid_max
+ * @return One more than the largest PID the kernel hands out, or PID_MAX_LIMIT if unreadable
+ */
+[[nodiscard]] int readPidMax();
+
+/**
+ * @brief Read the aggregate "cpu" line of /proc/stat
+ * @param times Output, summed over all CPUs
+ * @return false if /proc/stat could not be read or parsed
+ */
+[[nodiscard]] bool readSystemCpuTimes(CpuTimes& times);
+
+/**
+ * @brief Parse the "cpu" lines at the top of /proc/stat
+ * @param total Output, the aggregate line
+ * @param cores Output, indexed by CPU number; CPUs without a line (offline) are all zero
+ * @param complete Output, true if the data reaches past the last "cpu" line, false if it
+ *                 was cut off within them
+ * @return false if the aggregate line is missing or malformed
+ */
+[[nodiscard]] bool parseCpuLines(const char* data, std::size_t length, CpuTimes& total, std::vector<CpuTimes>& cores,
+                                 bool& complete);
+
+/**
+ * @brief Parse the counters following the label of a "cpu" line of /proc/stat
+ * @param cursor In/out position, just past the label on entry
+ * @return true if at least user, nice, system and idle were present
+ */
+[[nodiscard]] bool parseCpuTimes(const char*& cursor, const char* end, CpuTimes& times);
+
+/**
+ * @brief Parse the contents of /proc/[PID]/stat
+ * @return true if all fields up to rss were present
+ */
+[[nodiscard]] bool parseStat(const char* data, std::size_t length, ProcessStat& stat);
+
+/**
+ * @brief Format "<pid>/<name>" for openat() relative to /proc without allocating
+ * @return Pointer to buffer
+ */
+const char* formatProcessPath(int pid, const char* name, char* buffer, std::size_t capacity);
+
+/**
+ * @brief Parse an unsigned decimal integer, skipping leading blanks
+ * @param cursor In/out position, left just past the last digit
+ * @return true if at least one digit was consumed
+ */
+[[nodiscard]] bool parseUnsigned(const char*& cursor, const char* end, unsigned long long& value);
+
+/**
+ * @brief Parse an optionally negative decimal integer, skipping leading blanks
+ * @param cursor In/out position, left just past the last digit
+ * @return true if at least one digit was consumed
+ */
+[[nodiscard]] bool parseSigned(const char*& cursor, const char* end, long long& value);
+
+/**
+ * @brief Per-process files that ProcessFileCache keeps open
+ */
+enum class ProcessFile {
+    Stat,
+    Count
+};
+
+/**
+ * @brief File name inside /proc/[PID] of a ProcessFile, e.g. "stat"
+ */
+[[nodiscard]] const char* processFileName(ProcessFile file);
+
+/**
+ * @brief Keeps /proc/[PID] file descriptors open across refreshes
+ *
+ * Long-lived processes are re-sampled with pread(fd, buf, n, 0) instead of
+ * open/read/close. Entries are evicted when a read reports the process gone
+ * (ESRCH or EOF), when the caller detects PID reuse or when a scan no longer
+ * sees the PID. Once the bound derived from RLIMIT_NOFILE is reached, new
+ * PIDs are read with a one-shot openat/read/close until sweep() makes room.
+ */
+class ProcessFileCache {
+public:
+    explicit ProcessFileCache(std::size_t capacity = defaultCapacity());
+
+    ProcessFileCache(const ProcessFileCache&) = delete;
+    ProcessFileCache& operator=(const ProcessFileCache&) = delete;
+
+    /**
+     * @brief Number of processes that fit in the current RLIMIT_NOFILE soft limit
+     */
+    [[nodiscard]] static std::size_t defaultCapacity();
+
+    /**
+     * @brief Raise the RLIMIT_NOFILE soft limit to the hard limit
+     */
+    static void raiseDescriptorLimit();
+
+    /**
+     * @brief Read a whole per-process file, reusing a cached descriptor when possible
+     * @return Number of bytes read, or -1 if the process no longer exists
+     */
+    [[nodiscard]] ssize_t read(int procDirFd, int pid, ProcessFile file, char* buffer, std::size_t capacity);
+
+    /**
+     * @brief Record the start time of the process behind a cached PID
+     * @return false if it differs from the recorded one (PID reuse); the entry is then evicted
+     */
+    bool validateStartTime(int pid, unsigned long long startTime);
+
+    /**
+     * @brief Keep a live PID's descriptors through sweep() without parsing them
+     * @return false if no descriptors are cached for the PID, or if the process
+     *         they were opened for has exited; the entry is then evicted
+     */
+    [[nodiscard]] bool retain(int pid);
+
+    /**
+     * @brief Close all descriptors held for a PID
+     */
+    void evict(int pid);
+
+    /**
+     * @brief Start a new scan; entries not read before sweep() are considered dead
+     */
+    void beginScan() { ++m_scanGeneration; }
+
+    /**
+     * @brief Evict every entry that was not read since beginScan()
+     */
+    void sweep();
+
+    [[nodiscard]] std::size_t size() const { return m_entries.size(); }
+    [[nodiscard]] std::size_t capacity() const { return m_capacity; }
+
+private:
+    struct Entry {
+        FileDescriptor files[static_cast<int>(ProcessFile::Count)];
+        unsigned long long startTime = 0;
+        unsigned long long scanGeneration = 0;
+        std::list<int>::iterator lruPosition;
+    };
+
+    Entry* open_(int procDirFd, int pid);
+
+    std::size_t m_capacity;
+    unsigned long long m_scanGeneration;
+    std::unordered_map<int, Entry> m_entries;
+    std::list<int> m_lru;  // Most recently used PID at the front
+};
+
+} // namespace procfs
+
+#endif // PROCFS_H
@@ -0,0 +1,108 @@
+#ifndef REFRESHCOORDINATOR_H
+#define REFRESHCOORDINATOR_H
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Merges refresh requests from the timer, the GUI and process actions
+ *
+ * At most one full scan is in flight and at most one more is pending; any
+ * number of requests made while a scan runs collapse into that pending
+ * scan. Re-reads of individual PIDs (e.g. after a signal was sent) are
+ * batched the same way and dropped when a full scan that has not started
+ * yet will cover them anyway. All methods are thread-safe.
+ */
+class RefreshCoordinator {
+public:
+    /**
+     * @brief Ask for a full scan
+     * @return true if the caller must start one; false if merged into a scan in flight
+     */
+    [[nodiscard]] bool requestScan() {
+        ScanState state = m_scanState.load();
+        for (;;) {
+            ScanState next = state;
+            if (state == ScanState::Idle) {
+                next = ScanState::Queued;
+            } else if (state == ScanState::Running) {
+                next = ScanState::Pending;
+            }
+
+            if (m_scanState.compare_exchange_weak(state, next)) {
+                return state == ScanState::Idle;
+            }
+        }
+    }
+
+    /**
+     * @brief Report that the queued full scan starts reading /proc
+     */
+    void beginScan() {
+        m_scanState = ScanState::Running;
+    }
+
+    /**
+     * @brief Report that a full scan finished
+     * @return true if requests arrived while it ran and the caller must scan again
+     */
+    [[nodiscard]] bool finishScan() {
+        ScanState state = m_scanState.load();
+        for (;;) {
+            const ScanState next = state == ScanState::Pending ? ScanState::Queued : ScanState::Idle;
+            if (m_scanState.compare_exchange_weak(state, next)) {
+                return next == ScanState::Queued;
+            }
+        }
+    }
+
+    /**
+     * @brief Ask for a targeted re-read of some PIDs
+     * @return true if the caller must start one; false if merged into a queued re-read
+     *         or covered by a pending full scan
+     */
+    [[nodiscard]] bool requestProcesses(const std::vector<int>& pids) {
+        const ScanState state = m_scanState.load();
+        if (state == ScanState::Queued || state == ScanState::Pending) {
+            return false;  // A scan that has not read /proc yet re-reads these anyway
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_pendingPids.insert(m_pendingPids.end(), pids.begin(), pids.end());
+        const bool start = !m_processesQueued;
+        m_processesQueued = true;
+        return start;
+    }
+
+    /**
+     * @brief Take the PIDs of the queued targeted re-read, sorted and without duplicates
+     */
+    [[nodiscard]] std::vector<int> takeProcesses() {
+        QMutexLocker locker(&m_mutex);
+        std::vector<int> pids;
+        pids.swap(m_pendingPids);
+        m_processesQueued = false;
+
+        std::sort(pids.begin(), pids.end());
+        pids.erase(std::unique(pids.begin(), pids.end()), pids.end());
+        return pids;
+    }
+
+private:
+    enum class ScanState {
+        Idle,     // No scan queued or running
+        Queued,   // A scan is queued but has not started
+        Running,  // A scan is running
+        Pending   // A scan is running and another was requested after it started
+    };
+
+    std::atomic<ScanState> m_scanState{ScanState::Idle};
+    QMutex m_mutex;
+    std::vector<int> m_pendingPids;
+    bool m_processesQueued = false;
+};
+
+#endif // REFRESHCOORDINATOR_H
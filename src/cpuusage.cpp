@@ -0,0 +1,100 @@
+#include "cpuusage.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+namespace procfs {
+
+/**
+ * @brief Size the read buffer for every configured CPU, online or not
+ */
+CpuUsageCollector::CpuUsageCollector() {
+    const long configuredCpus = sysconf(_SC_NPROCESSORS_CONF);
+    const std::size_t lines = static_cast<std::size_t>(std::max(1L, configuredCpus)) + 1;
+    m_buffer.resize(lines * BYTES_PER_CPU_LINE);
+}
+
+/**
+ * @brief Read /proc/stat and compute usage since the previous sample
+ */
+bool CpuUsageCollector::sample() {
+    for (;;) {
+        const ssize_t length = readFile("/proc/stat", m_buffer.data(), m_buffer.size());
+        if (length <= 0) {
+            return false;
+        }
+
+        // The buffer only has to hold the "cpu" lines; the rest of the file
+        // (interrupt counters and more) is cut off on purpose
+        bool complete = false;
+        if (!parseCpuLines(m_buffer.data(), static_cast<std::size_t>(length), m_total, m_cores, complete)) {
+            return false;
+        }
+
+        // Grow only if CPU lines themselves were cut off (e.g. CPUs hot-added since startup)
+        if (!complete && static_cast<std::size_t>(length) + 1 >= m_buffer.size()) {
+            m_buffer.resize(m_buffer.size() * 2);
+            continue;
+        }
+        break;
+    }
+
+    m_onlineCoreCount = std::max<int>(1, static_cast<int>(std::count_if(
+        m_cores.begin(), m_cores.end(), [](const CpuTimes& times) { return times.total() != 0; })));
+
+    if (m_hasPrevious) {
+        m_usage.valid = true;
+        m_usage.total = usageBetween_(m_previousTotal, m_total);
+        m_usage.cores.resize(m_cores.size());
+        for (std::size_t cpu = 0; cpu < m_cores.size(); ++cpu) {
+            m_usage.cores[cpu] = cpu < m_previousCores.size() ? usageBetween_(m_previousCores[cpu], m_cores[cpu])
+                                                               : CpuUsage();
+        }
+    }
+
+    m_previousTotal = m_total;
+    m_previousCores = m_cores;
+    m_hasPrevious = true;
+    return true;
+}
+
+/**
+ * @brief Percentages of the interval between two readings of the same CPU
+ *
+ * A counter that went backwards (iowait may on some kernels, and every
+ * counter restarts when a CPU comes back online) counts as zero.
+ */
+CpuUsage CpuUsageCollector::usageBetween_(const CpuTimes& previous, const CpuTimes& current) {
+    const auto delta = [&](unsigned long long CpuTimes::* field) {
+        return current.*field >= previous.*field ? current.*field - previous.*field : 0ULL;
+    };
+
+    CpuTimes elapsed;
+    elapsed.user = delta(&CpuTimes::user);
+    elapsed.nice = delta(&CpuTimes::nice);
+    elapsed.system = delta(&CpuTimes::system);
+    elapsed.idle = delta(&CpuTimes::idle);
+    elapsed.iowait = delta(&CpuTimes::iowait);
+    elapsed.irq = delta(&CpuTimes::irq);
+    elapsed.softirq = delta(&CpuTimes::softirq);
+    elapsed.steal = delta(&CpuTimes::steal);
+
+    const unsigned long long total = elapsed.total();
+    if (total == 0) {
+        return CpuUsage();
+    }
+
+    const double scale = 100.0 / static_cast<double>(total);
+    CpuUsage usage;
+    usage.user = static_cast<double>(elapsed.user) * scale;
+    usage.nice = static_cast<double>(elapsed.nice) * scale;
+    usage.system = static_cast<double>(elapsed.system) * scale;
+    usage.idle = static_cast<double>(elapsed.idle) * scale;
+    usage.iowait = static_cast<double>(elapsed.iowait) * scale;
+    usage.irq = static_cast<double>(elapsed.irq) * scale;
+    usage.softirq = static_cast<double>(elapsed.softirq) * scale;
+    usage.steal = static_cast<double>(elapsed.steal) * scale;
+    return usage;
+}
+
+} // namespace procfs
@@ -8,6 +8,7 @@
 #include <QVBoxLayout>
 #include <QPushButton>
 #include <QLabel>
+#include <QDoubleSpinBox>
 #include <QStatusBar>
 #include <QMessageBox>
 #include <QAction>
@@ -21,6 +22,8 @@
 #include <QDebug>
 #include <QIcon>
 #include <QMap>
+#include <QHash>
+#include <QStringList>
 #include <algorithm>
 
 /**
@@ -31,18 +34,24 @@ MainWindow::MainWindow(QWidget* parent)
     , m_mainLayout(std::make_unique<QVBoxLayout>())
     , m_toolbarLayout(std::make_unique<QHBoxLayout>())
     , m_processTreeView(std::make_unique<QTreeView>(this))
-    , m_processModel(std::make_unique<QStandardItemModel>(this))
+    , m_processModel(std::make_unique<ProcessTreeModel>(this))
     , m_refreshButton(std::make_unique<QPushButton>("Refresh", this))
     , m_autoRefreshButton(std::make_unique<QPushButton>("Auto Refresh", this))
     , m_focusModeButton(std::make_unique<QPushButton>("Focus Mode", this))
+    , m_cpuBudgetSpinBox(std::make_unique<QDoubleSpinBox>(this))
+    , m_layoutComboBox(std::make_unique<QComboBox>(this))
     , m_statusLabel(std::make_unique<QLabel>("Ready", this))
     , m_processCountLabel(std::make_unique<QLabel>("Processes: 0", this))
+    , m_refreshIntervalLabel(std::make_unique<QLabel>(this))
+    , m_cpuUsageLabel(std::make_unique<QLabel>(this))
     , m_processManager(std::make_unique<ProcessManager>(this))
     , m_contextMenu(std::make_unique<QMenu>(this))
     , m_killProcessAction(std::make_unique<QAction>("Kill Process", this))
     , m_killGracefullyAction(std::make_unique<QAction>("Kill Gracefully", this))
     , m_suspendProcessAction(std::make_unique<QAction>("Suspend Process", this))
-    , m_resumeProcessAction(std::make_unique<QAction>("Resume Process", this)) {
+    , m_resumeProcessAction(std::make_unique<QAction>("Resume Process", this))
+    , m_showDetailsAction(std::make_unique<QAction>("Show Details", this))
+    , m_columnMenu(std::make_unique<QMenu>(this)) {
 
     // Set window properties
     setWindowTitle("LuminaTask - Linux System Monitor");
@@ -55,6 +64,7 @@ MainWindow::MainWindow(QWidget* parent)
     setupToolbar_();
     setupStatusBar_();
     setupContextMenu_();
+    setupColumnMenu_();
 
     // Connect signals and slots
     connect(m_processManager.get(), &ProcessManager::processesUpdated,
@@ -75,8 +85,17 @@ MainWindow::MainWindow(QWidget* parent)
             this, &MainWindow::onSuspendProcessAction_);
     connect(m_resumeProcessAction.get(), &QAction::triggered,
             this, &MainWindow::onResumeProcessAction_);
+    connect(m_showDetailsAction.get(), &QAction::triggered,
+            this, &MainWindow::onShowDetailsAction_);
     connect(m_processManager.get(), &ProcessManager::memoryLeakDetected,
             this, &MainWindow::onMemoryLeakDetected_);
+    connect(m_cpuBudgetSpinBox.get(), QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &MainWindow::onCpuBudgetChanged_);
+    connect(m_layoutComboBox.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onLayoutChanged_);
+    connect(m_processManager.get(), &ProcessManager::refreshIntervalChanged,
+            this, &MainWindow::onRefreshIntervalChanged_);
+    onRefreshIntervalChanged_(static_cast<int>(m_processManager->refreshInterval().count()));
 
     // Initial process list load
     onRefreshButtonClicked_();
@@ -143,6 +162,12 @@ void MainWindow::setupTreeView_() {
     header->setSectionResizeMode(TREE_COLUMN_PID, QHeaderView::ResizeToContents);
     header->setSectionResizeMode(TREE_COLUMN_COUNT, QHeaderView::ResizeToContents);
 
+    // Threads are only read while a process row is expanded
+    connect(m_processTreeView.get(), &QTreeView::expanded,
+            this, &MainWindow::onTreeItemExpanded_);
+    connect(m_processTreeView.get(), &QTreeView::collapsed,
+            this, &MainWindow::onTreeItemCollapsed_);
+
     // Connect context menu signal
     connect(m_processTreeView.get(), &QTreeView::customContextMenuRequested,
             [this](const QPoint& pos) {
@@ -164,11 +189,24 @@ void MainWindow::setupToolbar_() {
     m_focusModeButton->setChecked(false);
     m_focusModeButton->setIcon(QIcon::fromTheme("applications-games"));
     m_focusModeButton->setToolTip("Enable Focus Mode (Game Mode) - Optimizes system for foreground app");
+    m_cpuBudgetSpinBox->setRange(0.0, 100.0);
+    m_cpuBudgetSpinBox->setDecimals(1);
+    m_cpuBudgetSpinBox->setSingleStep(0.5);
+    m_cpuBudgetSpinBox->setSuffix("% CPU");
+    m_cpuBudgetSpinBox->setSpecialValueText("No CPU budget");
+    m_cpuBudgetSpinBox->setValue(0.0);
+    m_cpuBudgetSpinBox->setToolTip("Limit LuminaTask's own CPU use to this share of one core "
+                                   "by refreshing less often");
+    m_layoutComboBox->addItem("Group by Name");
+    m_layoutComboBox->addItem("Process Tree");
+    m_layoutComboBox->setToolTip("Group processes by name, or show each under the process that started it");
 
     // Add buttons to toolbar layout
     m_toolbarLayout->addWidget(m_refreshButton.get());
     m_toolbarLayout->addWidget(m_autoRefreshButton.get());
     m_toolbarLayout->addWidget(m_focusModeButton.get());
+    m_toolbarLayout->addWidget(m_cpuBudgetSpinBox.get());
+    m_toolbarLayout->addWidget(m_layoutComboBox.get());
     m_toolbarLayout->addStretch();
     m_toolbarLayout->addWidget(m_processCountLabel.get());
 
@@ -184,6 +222,8 @@ void MainWindow::setupToolbar_() {
  */
 void MainWindow::setupStatusBar_() {
     statusBar()->addWidget(m_statusLabel.get());
+    statusBar()->addPermanentWidget(m_cpuUsageLabel.get());
+    statusBar()->addPermanentWidget(m_refreshIntervalLabel.get());
     statusBar()->addPermanentWidget(m_processCountLabel.get());
 }
 
@@ -196,8 +236,11 @@ void MainWindow::setupContextMenu_() {
     m_killGracefullyAction->setIcon(QIcon::fromTheme("system-shutdown"));
     m_suspendProcessAction->setIcon(QIcon::fromTheme("media-playback-pause"));
     m_resumeProcessAction->setIcon(QIcon::fromTheme("media-playback-start"));
+    m_showDetailsAction->setIcon(QIcon::fromTheme("dialog-information"));
 
     // Add actions to context menu
+    m_contextMenu->addAction(m_showDetailsAction.get());
+    m_contextMenu->addSeparator();
     m_contextMenu->addAction(m_suspendProcessAction.get());
     m_contextMenu->addAction(m_resumeProcessAction.get());
     m_contextMenu->addSeparator();
@@ -205,22 +248,130 @@ void MainWindow::setupContextMenu_() {
     m_contextMenu->addAction(m_killProcessAction.get());
 }
 
+/**
+ * @brief Setup the header menu that shows and hides columns
+ *
+ * The name column anchors the tree and is always shown.
+ */
+void MainWindow::setupColumnMenu_() {
+    QHeaderView* header = m_processTreeView->header();
+    header->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(header, &QHeaderView::customContextMenuRequested,
+            this, &MainWindow::onHeaderContextMenuRequested_);
+
+    for (int column = 0; column < m_processModel->columnCount(); ++column) {
+        if (column == TREE_COLUMN_NAME) {
+            continue;
+        }
+
+        QAction* action = m_columnMenu->addAction(
+            m_processModel->headerData(column, Qt::Horizontal).toString());
+        action->setCheckable(true);
+        action->setChecked(!m_processTreeView->isColumnHidden(column));
+        connect(action, &QAction::toggled, this, [this, column](bool checked) {
+            setColumnVisible_(column, checked);
+        });
+    }
+
+    updateFieldMask_();
+}
+
+/**
+ * @brief Show the column menu for a right-click on the tree header
+ */
+void MainWindow::onHeaderContextMenuRequested_(const QPoint& pos) {
+    m_columnMenu->exec(m_processTreeView->header()->mapToGlobal(pos));
+}
+
+/**
+ * @brief Show or hide a tree column and collect only what is displayed
+ */
+void MainWindow::setColumnVisible_(int column, bool visible) {
+    m_processTreeView->setColumnHidden(column, !visible);
+    updateFieldMask_();
+
+    // A newly shown column is empty until the next scan; don't wait for the timer
+    if (visible) {
+        onRefreshButtonClicked_();
+    }
+}
+
+/**
+ * @brief Push the field mask of the visible columns to the process manager
+ */
+void MainWindow::updateFieldMask_() {
+    const std::pair<int, ProcessField> columnFields[] = {
+        {TREE_COLUMN_STATE, ProcessField::State},
+        {TREE_COLUMN_MEMORY, ProcessField::Memory},
+        {TREE_COLUMN_CPU, ProcessField::Cpu},
+        {TREE_COLUMN_PRIORITY, ProcessField::Priority},
+    };
+
+    ProcessFields fields;
+    for (const auto& [column, field] : columnFields) {
+        if (!m_processTreeView->isColumnHidden(column)) {
+            fields |= field;
+        }
+    }
+
+    m_processManager->setFieldMask(fields);
+}
+
 /**
  * @brief Handle processes updated signal
  */
-void MainWindow::onProcessesUpdated_(const QVector<ProcessInfo>& processes) {
-    updateProcessTree_(processes);
+void MainWindow::onProcessesUpdated_(const ProcessSnapshotPtr& snapshot) {
+    m_displayedSnapshot = snapshot;
+    updateProcessTree_(*snapshot);
+    updateCpuUsageLabel_(snapshot->cpu);
     m_statusLabel->setText("Processes updated");
 }
 
+/**
+ * @brief Show overall CPU load, the busiest core and steal time in the status bar
+ *
+ * The busiest core reveals a saturated single-threaded bottleneck that the
+ * average hides; the tooltip breaks the load down per core.
+ */
+void MainWindow::updateCpuUsageLabel_(const procfs::SystemCpuUsage& cpu) {
+    if (!cpu.valid) {
+        m_cpuUsageLabel->setText("CPU: --");
+        return;
+    }
+
+    double busiestCore = 0.0;
+    QStringList coreLines;
+    for (std::size_t core = 0; core < cpu.cores.size(); ++core) {
+        const procfs::CpuUsage& usage = cpu.cores[core];
+        busiestCore = std::max(busiestCore, usage.busy());
+        coreLines << QString("CPU %1: %2% busy (user %3%, system %4%, iowait %5%, steal %6%)")
+                         .arg(core)
+                         .arg(usage.busy(), 0, 'f', 0)
+                         .arg(usage.user + usage.nice, 0, 'f', 0)
+                         .arg(usage.system + usage.irq + usage.softirq, 0, 'f', 0)
+                         .arg(usage.iowait, 0, 'f', 0)
+                         .arg(usage.steal, 0, 'f', 0);
+    }
+
+    QString text = QString("CPU: %1% (busiest core %2%)")
+                       .arg(cpu.total.busy(), 0, 'f', 0)
+                       .arg(busiestCore, 0, 'f', 0);
+    if (cpu.total.steal >= 0.5) {
+        text += QString(", steal %1%").arg(cpu.total.steal, 0, 'f', 1);
+    }
+
+    m_cpuUsageLabel->setText(text);
+    m_cpuUsageLabel->setToolTip(coreLines.join('\n'));
+}
+
 /**
  * @brief Handle process terminated signal
  */
 void MainWindow::onProcessTerminated_(int pid, bool success) {
     if (success) {
         m_statusLabel->setText(QString("Process %1 terminated successfully").arg(pid));
-        // Refresh the list to show updated state
-        onRefreshButtonClicked_();
+        // Re-read just this process to show the updated state
+        m_processManager->requestProcessRefresh({pid});
     } else {
         showErrorMessage_("Termination Failed",
                          QString("Failed to terminate process %1").arg(pid));
@@ -232,9 +383,7 @@ void MainWindow::onProcessTerminated_(int pid, bool success) {
  */
 void MainWindow::onRefreshButtonClicked_() {
     m_statusLabel->setText("Refreshing process list...");
-    const QVector<ProcessInfo> processes = m_processManager->getAllProcesses();
-    updateProcessTree_(processes);
-    m_statusLabel->setText("Process list refreshed");
+    m_processManager->requestRefresh();  // The tree is rebuilt from processesUpdated()
 }
 
 /**
@@ -250,6 +399,32 @@ void MainWindow::onAutoRefreshToggled_(bool enabled) {
     }
 }
 
+/**
+ * @brief Handle CPU budget changes
+ */
+void MainWindow::onCpuBudgetChanged_(double percentOfCore) {
+    m_processManager->setCpuBudget(percentOfCore);
+}
+
+/**
+ * @brief Show the refresh interval the process manager currently runs at
+ */
+void MainWindow::onRefreshIntervalChanged_(int intervalMs) {
+    m_refreshIntervalLabel->setText(QString("Interval: %1 s").arg(intervalMs / 1000.0, 0, 'f', 1));
+}
+
+/**
+ * @brief Switch between name groups and the parent/child tree
+ */
+void MainWindow::onLayoutChanged_(int index) {
+    m_treeLayout = index == 1 ? TreeLayout::ByParent : TreeLayout::ByName;
+
+    // Rebuild from the shown snapshot rather than waiting for the next refresh
+    if (m_displayedSnapshot) {
+        updateProcessTree_(*m_displayedSnapshot);
+    }
+}
+
 /**
  * @brief Handle kill process action
  */
@@ -301,15 +476,16 @@ void MainWindow::onSuspendProcessAction_() {
     const QString question = QString("Are you sure you want to suspend process %1 (%2)?")
                            .arg(pid).arg(processInfo->name);
 
+    const ProcessTable::Handle handle = displayedHandle_(pid);
     const QMessageBox::StandardButton reply = QMessageBox::question(
         this, "Confirm Process Suspension", question,
         QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
 
-    if (reply == QMessageBox::Yes) {
+    if (reply == QMessageBox::Yes && confirmStillRunning_(pid, handle)) {
         const bool success = m_processManager->suspendProcess(pid);
         if (success) {
             m_statusLabel->setText(QString("Process %1 suspended successfully").arg(pid));
-            onRefreshButtonClicked_();  // Refresh to show updated state
+            m_processManager->requestProcessRefresh({pid});  // Re-read to show updated state
         } else {
             showErrorMessage_("Suspension Failed",
                              QString("Failed to suspend process %1").arg(pid));
@@ -322,18 +498,35 @@ void MainWindow::onSuspendProcessAction_() {
  */
 void MainWindow::onResumeProcessAction_() {
     const int pid = getSelectedProcessPID_();
-    if (pid == -1) return;
+    if (pid == -1 || !confirmStillRunning_(pid, displayedHandle_(pid))) return;
 
     const bool success = m_processManager->resumeProcess(pid);
     if (success) {
         m_statusLabel->setText(QString("Process %1 resumed successfully").arg(pid));
-        onRefreshButtonClicked_();  // Refresh to show updated state
+        m_processManager->requestProcessRefresh({pid});  // Re-read to show updated state
     } else {
         showErrorMessage_("Resume Failed",
                          QString("Failed to resume process %1").arg(pid));
     }
 }
 
+/**
+ * @brief Handle show details action
+ */
+void MainWindow::onShowDetailsAction_() {
+    const int pid = getSelectedProcessPID_();
+    if (pid == -1) return;
+
+    const std::optional<QString> details = m_processManager->getProcessDetails(pid);
+    if (!details) {
+        showErrorMessage_("Details Unavailable",
+                         QString("Process %1 no longer exists").arg(pid));
+        return;
+    }
+
+    QMessageBox::information(this, QString("Process %1 Details").arg(pid), *details);
+}
+
 /**
  * @brief Handle focus mode toggle
  */
@@ -376,44 +569,81 @@ void MainWindow::onMemoryLeakDetected_(int pid, const QString& processName, doub
 /**
  * @brief Update the process tree with new data
  */
-void MainWindow::updateProcessTree_(const QVector<ProcessInfo>& processes) {
-    // Clear existing data
+void MainWindow::updateProcessTree_(const ProcessSnapshot& snapshot) {
+    // Clear existing data. With sorting enabled every appended row would
+    // re-sort the model, which is quadratic with tens of thousands of rows.
+    const bool sortingEnabled = m_processTreeView->isSortingEnabled();
+    m_processTreeView->setSortingEnabled(false);
     clearProcessTree_();
 
-    // Group processes by name
-    QMap<QString, QVector<ProcessInfo>> processGroups;
-    for (const auto& process : processes) {
-        processGroups[process.name].append(process);
+    QVector<QStandardItem*> expandedProcessItems;
+    if (m_treeLayout == TreeLayout::ByParent) {
+        addParentTreeRows_(snapshot, expandedProcessItems);
+    } else {
+        addGroupRows_(snapshot, expandedProcessItems);
+    }
+
+    // Update process count
+    m_processCountLabel->setText(QString("Processes: %1").arg(snapshot.table.size()));
+
+    m_processTreeView->setSortingEnabled(sortingEnabled);
+
+    // Stop reading threads of expanded processes that exited, including
+    // those whose PID now belongs to another process
+    for (auto it = m_expandedProcesses.begin(); it != m_expandedProcesses.end();) {
+        if (snapshot.table.isValid(it.value())) {
+            ++it;
+            continue;
+        }
+        m_processManager->watchThreads(it.key(), false);
+        it = m_expandedProcesses.erase(it);
+    }
+
+    // Expand the top level by default, and the processes whose threads were shown before.
+    // They are already in m_expandedProcesses, so expanding them does not ask for threads again.
+    m_processTreeView->expandToDepth(0);
+    for (QStandardItem* item : expandedProcessItems) {
+        m_processTreeView->setExpanded(item->index(), true);
+    }
+}
+
+/**
+ * @brief Add one top-level row per process name, with the processes as children
+ */
+void MainWindow::addGroupRows_(const ProcessSnapshot& snapshot, QVector<QStandardItem*>& expandedProcessItems) {
+    const ProcessTable& table = snapshot.table;
+
+    // Group processes by interned name ID, reading only the table columns that grouping needs.
+    // Slots are visited in PID order, so child order is stable.
+    std::vector<int> groupIndices(table.names().idCount(), -1);
+    QVector<ProcessGroup> groups;
+    for (const ProcessTable::Slot slot : table.liveSlots()) {
+        int& groupIndex = groupIndices[table.nameId(slot)];
+        if (groupIndex == -1) {
+            groupIndex = groups.size();
+            groups.append({table.name(slot), {slot}, table.memoryMB(slot), table.cpuPercent(slot)});
+        } else {
+            ProcessGroup& group = groups[groupIndex];
+            group.members.append(slot);
+            group.totalMemory += table.memoryMB(slot);
+            group.totalCpu += table.cpuPercent(slot);
+        }
     }
 
     // Sort groups by total memory usage (descending)
-    QVector<QPair<QString, QVector<ProcessInfo>>> sortedGroups;
-    for (auto it = processGroups.begin(); it != processGroups.end(); ++it) {
-        sortedGroups.append(qMakePair(it.key(), it.value()));
-    }
-    std::sort(sortedGroups.begin(), sortedGroups.end(),
-              [](const QPair<QString, QVector<ProcessInfo>>& a,
-                 const QPair<QString, QVector<ProcessInfo>>& b) {
-                  double totalMemoryA = 0.0;
-                  for (const auto& proc : a.second) totalMemoryA += proc.memoryMB;
-                  double totalMemoryB = 0.0;
-                  for (const auto& proc : b.second) totalMemoryB += proc.memoryMB;
-                  return totalMemoryA > totalMemoryB;
+    std::sort(groups.begin(), groups.end(),
+              [](const ProcessGroup& a, const ProcessGroup& b) {
+                  if (a.totalMemory != b.totalMemory) {
+                      return a.totalMemory > b.totalMemory;
+                  }
+                  return a.name < b.name;
               });
 
     // Add grouped process data
-    for (const auto& group : sortedGroups) {
-        const QString& processName = group.first;
-        const QVector<ProcessInfo>& groupProcesses = group.second;
-
-        // Calculate group totals
-        double totalMemory = 0.0;
-        double avgCpu = 0.0;
-        for (const auto& proc : groupProcesses) {
-            totalMemory += proc.memoryMB;
-            avgCpu += proc.cpuPercent;
-        }
-        avgCpu /= groupProcesses.size();
+    for (const ProcessGroup& group : groups) {
+        const QString& processName = group.name;
+        const double totalMemory = group.totalMemory;
+        const double avgCpu = group.totalCpu / group.members.size();
 
         // Create parent item (group)
         QList<QStandardItem*> groupRow;
@@ -438,77 +668,223 @@ void MainWindow::updateProcessTree_(const QVector<ProcessInfo>& processes) {
         QStandardItem* pidItem = new QStandardItem("");  // Empty for groups
         groupRow << pidItem;
 
-        QStandardItem* countItem = new QStandardItem(QString::number(groupProcesses.size()));
-        countItem->setData(groupProcesses.size(), Qt::UserRole);
+        QStandardItem* countItem = new QStandardItem(QString::number(group.members.size()));
+        countItem->setData(group.members.size(), Qt::UserRole);
         groupRow << countItem;
 
         m_processModel->appendRow(groupRow);
 
         // Add child items (individual processes)
-        for (const auto& process : groupProcesses) {
-            QList<QStandardItem*> processRow;
-            QStandardItem* childNameItem = new QStandardItem("  " + process.name);
-            childNameItem->setData(process.pid, Qt::UserRole);  // Store PID for context menu
-            processRow << childNameItem;
-
-            // State column with visual indicator
-            QStandardItem* childStateItem = new QStandardItem();
-            if (process.state == ProcessState::Suspended) {
-                childStateItem->setText("❄️ Suspended");
-                childStateItem->setForeground(QBrush(QColor(100, 150, 200)));  // Light blue color
-            } else {
-                childStateItem->setText("▶️ Running");
-                childStateItem->setForeground(QBrush(QColor(50, 150, 50)));   // Green color
-            }
-            processRow << childStateItem;
-
-            QStandardItem* childMemoryItem = new QStandardItem(QString::number(process.memoryMB, 'f', 2));
-            childMemoryItem->setData(process.memoryMB, Qt::UserRole);
-            processRow << childMemoryItem;
-
-            QStandardItem* childCpuItem = new QStandardItem(QString::number(process.cpuPercent, 'f', 1));
-            childCpuItem->setData(process.cpuPercent, Qt::UserRole);
-            processRow << childCpuItem;
-
-            // Priority column with visual indicator
-            QStandardItem* childPriorityItem = new QStandardItem();
-            QString priorityText;
-            if (process.priority < -5) {
-                priorityText = QString("🔥 High (%1)").arg(process.priority);
-                childPriorityItem->setForeground(QBrush(QColor(255, 100, 100)));  // Red for high priority
-            } else if (process.priority > 5) {
-                priorityText = QString("🐌 Low (%1)").arg(process.priority);
-                childPriorityItem->setForeground(QBrush(QColor(150, 150, 150)));   // Gray for low priority
-            } else {
-                priorityText = QString("⚖️ Normal (%1)").arg(process.priority);
-                childPriorityItem->setForeground(QBrush(QColor(100, 100, 100)));
-            }
-            
-            // Add memory leak warning indicator
-            if (process.isMemoryLeech) {
-                priorityText = "⚠️ " + priorityText + " (LEAK!)";
-                childPriorityItem->setForeground(QBrush(QColor(255, 165, 0)));  // Orange for memory leak
-            }
-            
-            childPriorityItem->setText(priorityText);
-            processRow << childPriorityItem;
-
-            QStandardItem* childPidItem = new QStandardItem(QString::number(process.pid));
-            childPidItem->setData(process.pid, Qt::UserRole);
-            processRow << childPidItem;
-
-            QStandardItem* childCountItem = new QStandardItem("");  // Empty for individual processes
-            processRow << childCountItem;
-
+        for (const ProcessTable::Slot slot : group.members) {
+            const QList<QStandardItem*> processRow = createProcessRow_(snapshot, slot);
+            processRow.first()->setText("  " + processRow.first()->text());
+            attachThreads_(processRow.first(), slot, snapshot, expandedProcessItems);
             groupRow.first()->appendRow(processRow);
         }
     }
+}
 
-    // Update process count
-    m_processCountLabel->setText(QString("Processes: %1").arg(processes.size()));
+/**
+ * @brief Add processes under their parents, with subtree totals
+ *
+ * Memory, CPU and count show the process together with all of its
+ * descendants; the process's own figures are in the tooltips. Threads of a
+ * process with children sit under a separate "Threads" node, so expanding
+ * the process to navigate the hierarchy does not start reading threads.
+ */
+void MainWindow::addParentTreeRows_(const ProcessSnapshot& snapshot, QVector<QStandardItem*>& expandedProcessItems) {
+    const ProcessTable& table = snapshot.table;
+    m_processHierarchy.build(table);
+
+    // Pre-order visits parents first, so every parent's row exists when its children are added
+    std::vector<QStandardItem*> nameItems(table.slotCount(), nullptr);
+    for (const ProcessTable::Slot slot : m_processHierarchy.preOrder()) {
+        const QList<QStandardItem*> processRow = createProcessRow_(snapshot, slot);
+        if (m_processHierarchy.firstChild(slot) != ProcessTable::INVALID_SLOT) {
+            QStandardItem* threadsItem = new QStandardItem("Threads");
+            threadsItem->setData("threads", Qt::UserRole);
+            processRow.first()->appendRow(threadsItem);
+            attachThreads_(threadsItem, slot, snapshot, expandedProcessItems);
+        } else {
+            attachThreads_(processRow.first(), slot, snapshot, expandedProcessItems);
+        }
+
+        const double subtreeMemory = m_processHierarchy.subtreeMemoryMB(slot);
+        processRow[TREE_COLUMN_MEMORY]->setText(QString::number(subtreeMemory, 'f', 2));
+        processRow[TREE_COLUMN_MEMORY]->setData(subtreeMemory, Qt::UserRole);
+        processRow[TREE_COLUMN_MEMORY]->setToolTip(QString("Own: %1 MB").arg(table.memoryMB(slot), 0, 'f', 2));
+
+        const double subtreeCpu = m_processHierarchy.subtreeCpuPercent(slot);
+        processRow[TREE_COLUMN_CPU]->setText(QString::number(subtreeCpu, 'f', 1));
+        processRow[TREE_COLUMN_CPU]->setData(subtreeCpu, Qt::UserRole);
+        processRow[TREE_COLUMN_CPU]->setToolTip(QString("Own: %1%").arg(table.cpuPercent(slot), 0, 'f', 1));
+
+        const int subtreeSize = m_processHierarchy.subtreeSize(slot);
+        processRow[TREE_COLUMN_COUNT]->setText(QString::number(subtreeSize));
+        processRow[TREE_COLUMN_COUNT]->setData(subtreeSize, Qt::UserRole);
+
+        nameItems[slot] = processRow.first();
+        const ProcessTable::Slot parent = m_processHierarchy.parent(slot);
+        if (parent == ProcessTable::INVALID_SLOT) {
+            m_processModel->appendRow(processRow);
+        } else {
+            nameItems[parent]->appendRow(processRow);
+        }
+    }
+}
+
+/**
+ * @brief Create the row of one process
+ */
+QList<QStandardItem*> MainWindow::createProcessRow_(const ProcessSnapshot& snapshot, ProcessTable::Slot slot) {
+    const ProcessInfo process = snapshot.table.info(slot);
+    QList<QStandardItem*> processRow;
+    QStandardItem* childNameItem = new QStandardItem(process.name);
+    childNameItem->setData(process.pid, Qt::UserRole);  // Store PID for context menu
+    processRow << childNameItem;
+
+    // State column with visual indicator
+    QStandardItem* childStateItem = new QStandardItem();
+    if (process.state == ProcessState::Suspended) {
+        childStateItem->setText("❄️ Suspended");
+        childStateItem->setForeground(QBrush(QColor(100, 150, 200)));  // Light blue color
+    } else {
+        childStateItem->setText("▶️ Running");
+        childStateItem->setForeground(QBrush(QColor(50, 150, 50)));   // Green color
+    }
+    processRow << childStateItem;
+
+    QStandardItem* childMemoryItem = new QStandardItem(QString::number(process.memoryMB, 'f', 2));
+    childMemoryItem->setData(process.memoryMB, Qt::UserRole);
+    processRow << childMemoryItem;
+
+    QStandardItem* childCpuItem = new QStandardItem(QString::number(process.cpuPercent, 'f', 1));
+    childCpuItem->setData(process.cpuPercent, Qt::UserRole);
+    processRow << childCpuItem;
+
+    // Priority column with visual indicator
+    QStandardItem* childPriorityItem = new QStandardItem();
+    QString priorityText;
+    if (process.priority < -5) {
+        priorityText = QString("🔥 High (%1)").arg(process.priority);
+        childPriorityItem->setForeground(QBrush(QColor(255, 100, 100)));  // Red for high priority
+    } else if (process.priority > 5) {
+        priorityText = QString("🐌 Low (%1)").arg(process.priority);
+        childPriorityItem->setForeground(QBrush(QColor(150, 150, 150)));   // Gray for low priority
+    } else {
+        priorityText = QString("⚖️ Normal (%1)").arg(process.priority);
+        childPriorityItem->setForeground(QBrush(QColor(100, 100, 100)));
+    }
+    
+    // Add memory leak warning indicator
+    if (process.isMemoryLeech) {
+        priorityText = "⚠️ " + priorityText + " (LEAK!)";
+        childPriorityItem->setForeground(QBrush(QColor(255, 165, 0)));  // Orange for memory leak
+    }
+    
+    childPriorityItem->setText(priorityText);
+    processRow << childPriorityItem;
+
+    QStandardItem* childPidItem = new QStandardItem(QString::number(process.pid));
+    childPidItem->setData(process.pid, Qt::UserRole);
+    processRow << childPidItem;
+
+    QStandardItem* childCountItem = new QStandardItem("");  // Empty for individual processes
+    processRow << childCountItem;
+
+    return processRow;
+}
+
+/**
+ * @brief Make an item the one whose expansion shows a process's threads
+ * @param expandedProcessItems Receives the item if the process's threads are being shown
+ */
+void MainWindow::attachThreads_(QStandardItem* item, ProcessTable::Slot slot, const ProcessSnapshot& snapshot,
+                                QVector<QStandardItem*>& expandedProcessItems) {
+    const int pid = snapshot.table.pid(slot);
+
+    // Threads are only in the snapshot for expanded rows; the model keeps the others expandable
+    item->setData(pid, ProcessTreeModel::THREADS_PID_ROLE);
+    const auto threads = snapshot.threads.find(pid);
+    if (threads != snapshot.threads.end()) {
+        appendThreadRows_(item, threads->second);
+    }
 
-    // Expand all groups by default
-    m_processTreeView->expandAll();
+    // A new process that reused the PID of an expanded one starts collapsed
+    const auto expanded = m_expandedProcesses.constFind(pid);
+    if (expanded != m_expandedProcesses.constEnd() && *expanded == snapshot.table.handle(slot)) {
+        expandedProcessItems.append(item);
+    }
+}
+
+/**
+ * @brief Add one child row per thread under the item that shows a process's threads
+ */
+void MainWindow::appendThreadRows_(QStandardItem* processItem, const std::vector<ThreadInfo>& threads) {
+    for (const ThreadInfo& thread : threads) {
+        QList<QStandardItem*> threadRow;
+        QStandardItem* nameItem = new QStandardItem("    " + thread.name);
+        nameItem->setData("thread", Qt::UserRole);  // Threads are not valid targets for process actions
+        threadRow << nameItem;
+
+        QStandardItem* stateItem = new QStandardItem(thread.state == ProcessState::Suspended ? "❄️ Suspended"
+                                                                                            : "▶️ Running");
+        threadRow << stateItem;
+
+        threadRow << new QStandardItem("");  // Memory is shared by all threads
+
+        QStandardItem* cpuItem = new QStandardItem(QString::number(thread.cpuPercent, 'f', 1));
+        cpuItem->setData(thread.cpuPercent, Qt::UserRole);
+        threadRow << cpuItem;
+
+        QStandardItem* processorItem = new QStandardItem(thread.processor >= 0 ? QString("CPU %1").arg(thread.processor)
+                                                                               : QString());
+        processorItem->setToolTip("CPU the thread last ran on");
+        threadRow << processorItem;
+
+        QStandardItem* tidItem = new QStandardItem(QString::number(thread.tid));
+        tidItem->setData(thread.tid, Qt::UserRole);
+        tidItem->setToolTip("Thread ID");
+        threadRow << tidItem;
+
+        threadRow << new QStandardItem("");
+
+        processItem->appendRow(threadRow);
+    }
+}
+
+/**
+ * @brief PID of a process row, or -1 for group, thread and "Threads" rows
+ */
+int MainWindow::processRowPID_(const QModelIndex& index) const {
+    // Process name items hold their PID; groups, threads and "Threads" nodes hold a marker string
+    const QVariant data = m_processModel->itemFromIndex(index.siblingAtColumn(TREE_COLUMN_NAME))->data(Qt::UserRole);
+    return data.typeId() == QMetaType::Int ? data.toInt() : -1;
+}
+
+/**
+ * @brief Start showing the threads of a process when its row is expanded
+ */
+void MainWindow::onTreeItemExpanded_(const QModelIndex& index) {
+    const int pid = m_processModel->threadsPID(index);
+    if (pid <= 0 || m_expandedProcesses.contains(pid)) {
+        return;
+    }
+
+    m_expandedProcesses.insert(pid, displayedHandle_(pid));
+    m_processManager->watchThreads(pid, true);
+}
+
+/**
+ * @brief Stop reading the threads of a process when its row is collapsed
+ */
+void MainWindow::onTreeItemCollapsed_(const QModelIndex& index) {
+    const int pid = m_processModel->threadsPID(index);
+    if (pid <= 0 || !m_expandedProcesses.remove(pid)) {
+        return;
+    }
+
+    m_processManager->watchThreads(pid, false);
 }
 
 /**
@@ -535,14 +911,42 @@ int MainWindow::getSelectedProcessPID_() const {
         return -1;
     }
 
-    // Check if this is a group item (parent) or individual process item (child)
-    if (index.parent().isValid()) {
-        // This is a child item (individual process)
-        return m_processModel->itemFromIndex(index.siblingAtColumn(TREE_COLUMN_PID))->data(Qt::UserRole).toInt();
-    } else {
-        // This is a group item, don't allow termination of groups
-        return -1;
+    // Only individual processes can be acted on, not groups or threads
+    return processRowPID_(index);
+}
+
+/**
+ * @brief Handle of a process in the snapshot the tree shows
+ */
+ProcessTable::Handle MainWindow::displayedHandle_(int pid) const {
+    if (!m_displayedSnapshot) {
+        return {};
     }
+
+    const ProcessTable::Slot slot = m_displayedSnapshot->table.find(pid);
+    return slot != ProcessTable::INVALID_SLOT ? m_displayedSnapshot->table.handle(slot) : ProcessTable::Handle();
+}
+
+/**
+ * @brief Check, before signalling, that a process shown in the tree has not exited
+ * @return false (after telling the user) if the process is gone or its PID was reused
+ *
+ * A confirmation dialog can stay open across many refreshes, long enough
+ * for the kernel to give the PID to an unrelated process. Every snapshot
+ * is a copy of the same table, so a handle from the shown snapshot can be
+ * checked against the latest one. The latest snapshot can itself be a tick
+ * old, so the start time is then re-read from /proc before signalling.
+ */
+bool MainWindow::confirmStillRunning_(int pid, ProcessTable::Handle handle) {
+    const ProcessSnapshotPtr latest = m_processManager->snapshot();
+    if (latest && latest->table.isValid(handle) &&
+        m_processManager->isProcessRunning(latest->table.key(handle.slot))) {
+        return true;
+    }
+
+    showErrorMessage_("Process Exited",
+                      QString("Process %1 has exited; its PID may now belong to another process").arg(pid));
+    return false;
 }
 
 /**
@@ -560,11 +964,12 @@ void MainWindow::showConfirmationDialog_(int pid, const QString& processName, Te
     const QString question = QString("Are you sure you want to terminate process %1 (%2) %3?")
                            .arg(pid).arg(processName).arg(methodText);
 
+    const ProcessTable::Handle handle = displayedHandle_(pid);
     const QMessageBox::StandardButton reply = QMessageBox::question(
         this, "Confirm Process Termination", question,
         QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
 
-    if (reply == QMessageBox::Yes) {
+    if (reply == QMessageBox::Yes && confirmStillRunning_(pid, handle)) {
         const bool success = m_processManager->terminateProcess(pid, method);
         if (!success) {
             showErrorMessage_("Termination Failed",
@@ -1,26 +1,42 @@
 #include "processmanager.h"
 
-#include <QDir>
-#include <QFile>
-#include <QTextStream>
 #include <QDebug>
 #include <QStandardPaths>
 #include <QCoreApplication>
 #include <QThread>
+#include <QThreadPool>
 #include <QMutex>
 #include <QMutexLocker>
 #include <algorithm>
-#include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/resource.h>
 #include <pwd.h>
 #include <grp.h>
 #include <cstring>
 #include <cerrno>
 #include <cstdlib>
+#include <cmath>
+#include <ctime>
 #include <QDateTime>
-#include <QMap>
+#include <QHash>
+
+namespace {
+
+/**
+ * @brief CPU time consumed by this process so far, over all threads, in milliseconds
+ */
+double processCpuTimeMs() {
+    timespec time{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(time.tv_sec) * 1000.0 + static_cast<double>(time.tv_nsec) / 1e6;
+}
+
+} // namespace
 
 /**
  * @brief Constructor for ProcessManager
@@ -28,14 +44,42 @@
 ProcessManager::ProcessManager(QObject* parent)
     : QObject(parent)
     , m_refreshTimer(std::make_unique<QTimer>(this))
+    , m_procDirFd(::open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC))
+    , m_scanThread(std::make_unique<QThread>())
+    , m_scanContext(std::make_unique<QObject>())
     , m_focusModeEnabled(false) {
 
+    qRegisterMetaType<ProcessSnapshotPtr>();
+
+    if (!m_procDirFd.isValid()) {
+        qWarning() << "Failed to open /proc directory:" << strerror(errno);
+    }
+
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    m_pageSize = pageSize > 0 ? pageSize : 4096;
+    m_pidMax = procfs::readPidMax();
+    m_cpuCount = qMax(1, static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)));  // Until the first scan counts them
+
+    // Keep per-process descriptors open across refreshes, bounded by RLIMIT_NOFILE
+    procfs::ProcessFileCache::raiseDescriptorLimit();
+
+    // Scan worker pool; the calling thread always takes one shard itself
+    m_scanPool = std::make_unique<QThreadPool>();
+    setScanThreadCount(qMin(QThread::idealThreadCount(), DEFAULT_MAX_SCAN_THREADS));
+
+    // Opt-in batched io_uring reads for very large hosts
+    if (qEnvironmentVariableIntValue("LUMINATASK_IO_URING") != 0) {
+        (void)setScanBackend(ScanBackend::IoUring);  // Falls back to synchronous reads on failure
+    }
+
     // Connect timer signal
     connect(m_refreshTimer.get(), &QTimer::timeout,
             this, &ProcessManager::refreshProcessList_);
 
-    // Reserve space for cached processes
-    m_cachedProcesses.reserve(MAX_PROCESS_COUNT);
+    // Scans run on their own thread so the GUI stays responsive on big hosts
+    m_scanThread->setObjectName("LuminaTask scan");
+    m_scanContext->moveToThread(m_scanThread.get());
+    m_scanThread->start();
 }
 
 /**
@@ -43,50 +87,383 @@ ProcessManager::ProcessManager(QObject* parent)
  */
 ProcessManager::~ProcessManager() {
     stopPeriodicRefresh();
+
+    // Let an in-flight scan finish; queued scans are dropped with the event loop
+    m_scanThread->quit();
+    m_scanThread->wait();
+    m_scanPool->waitForDone();
 }
 
 /**
- * @brief Get information for all running processes
- * @return QVector of ProcessInfo structures
+ * @brief Run a function on the scan thread, after any scan already queued there
+ *
+ * Scan state (descriptor caches, sampling states, the process table and
+ * memory history) is only ever touched on the scan thread. Before the thread
+ * is started, e.g. from the constructor, the function runs immediately.
  */
-QVector<ProcessInfo> ProcessManager::getAllProcesses() {
-    QVector<ProcessInfo> processes;
-    processes.reserve(MAX_PROCESS_COUNT);
+void ProcessManager::runOnScanThread_(std::function<void()> function) {
+    if (!m_scanThread->isRunning()) {
+        function();
+        return;
+    }
 
-    // Open /proc directory
-    DIR* procDir = opendir("/proc");
-    if (!procDir) {
-        qWarning() << "Failed to open /proc directory:" << strerror(errno);
-        return processes;
+    QMetaObject::invokeMethod(m_scanContext.get(), std::move(function), Qt::QueuedConnection);
+}
+
+/**
+ * @brief Set the number of threads used to scan /proc
+ * @param threadCount Number of scan threads, including the scan thread itself
+ *
+ * Each thread owns a shard of the descriptor cache, so changing the count
+ * drops all cached descriptors. Takes effect from the next scan.
+ */
+void ProcessManager::setScanThreadCount(int threadCount) {
+    threadCount = qMax(1, threadCount);
+    runOnScanThread_([this, threadCount] { resizeScanShards_(threadCount); });
+}
+
+/**
+ * @brief Rebuild the descriptor cache shards for a new scan thread count
+ */
+void ProcessManager::resizeScanShards_(int threadCount) {
+    if (static_cast<std::size_t>(threadCount) == m_fileCaches.size()) {
+        return;
+    }
+
+    m_scanPool->waitForDone();
+    m_scanPool->setMaxThreadCount(qMax(1, threadCount - 1));
+
+    const std::size_t capacityPerShard =
+        procfs::ProcessFileCache::defaultCapacity() / static_cast<std::size_t>(threadCount);
+    m_fileCaches.clear();
+    for (int shard = 0; shard < threadCount; ++shard) {
+        m_fileCaches.push_back(std::make_unique<procfs::ProcessFileCache>(capacityPerShard));
+    }
+    m_shardIndices.assign(static_cast<std::size_t>(threadCount), {});
+    m_scanThreadCount = threadCount;
+}
+
+/**
+ * @brief Select how /proc is read during a scan
+ * @param backend Synchronous per-thread reads, or batched io_uring submissions
+ * @return true if the requested backend is active; false if io_uring is unavailable
+ *         and the synchronous backend stays in use
+ */
+bool ProcessManager::setScanBackend(ScanBackend backend) {
+    if (backend == ScanBackend::Synchronous) {
+        m_uringActive = false;
+        runOnScanThread_([this] { m_uringReader.reset(); });
+        return true;
+    }
+
+    if (m_uringActive) {
+        return true;
+    }
+
+    // Probe here so the caller learns the outcome; the ring is handed to the scan thread
+    auto reader = std::make_shared<std::unique_ptr<procfs::UringReader>>(procfs::UringReader::create());
+    if (!*reader) {
+        qWarning() << "io_uring is unavailable, keeping synchronous /proc reads";
+        return false;
+    }
+
+    m_uringActive = true;
+    runOnScanThread_([this, reader] { m_uringReader = std::move(*reader); });
+    return true;
+}
+
+/**
+ * @brief Queue a scan of /proc on the scan thread
+ *
+ * Returns immediately. When the scan is done its snapshot is published,
+ * focus mode is applied to it and processesUpdated() is emitted from the
+ * scan thread, i.e. delivered queued to receivers on the GUI thread.
+ * Requests made while a scan is queued are merged into it, and any made
+ * while one runs are merged into a single follow-up scan.
+ */
+void ProcessManager::requestRefresh() {
+    if (m_refreshCoordinator.requestScan()) {
+        runOnScanThread_([this] { scanAndPublish_(); });
+    }
+}
+
+/**
+ * @brief Queue a re-read of just a few processes, e.g. after signalling them
+ * @param pids Processes to re-read; any that exited are dropped from the table
+ *
+ * Much cheaper than a full scan. New processes only show up with the next
+ * full scan. Publishes a new snapshot like requestRefresh() does.
+ */
+void ProcessManager::requestProcessRefresh(const std::vector<int>& pids) {
+    if (m_refreshCoordinator.requestProcesses(pids)) {
+        runOnScanThread_([this] { rereadProcesses_(); });
+    }
+}
+
+/**
+ * @brief Scan /proc, publish the result and notify consumers; scan thread only
+ */
+void ProcessManager::scanAndPublish_() {
+    const double cpuTimeBefore = processCpuTimeMs();
+
+    m_refreshCoordinator.beginScan();
+    if (scan_()) {
+        publishSnapshot_();
+    }
+
+    if (const ProcessSnapshotPtr current = snapshot()) {
+        // Optimize for focused app if focus mode is enabled
+        if (m_focusModeEnabled) {
+            optimizeForFocusedApp_(*current);
+        }
+
+        emit processesUpdated(current);
+    }
+
+    recordScanCost_(processCpuTimeMs() - cpuTimeBefore);
+
+    // Requests that arrived since the scan started get exactly one more
+    if (m_refreshCoordinator.finishScan()) {
+        runOnScanThread_([this] { scanAndPublish_(); });
+    }
+}
+
+/**
+ * @brief Start or stop reading the threads of a process with every scan
+ * @param pid Process whose threads to watch
+ * @param watch true to include its threads in every snapshot, false to stop
+ *
+ * Watching a process re-reads the threads of every watched process right
+ * away and publishes a snapshot with them, so an expanded row fills in
+ * without waiting for the next scan. Watches end by themselves when the
+ * process exits.
+ */
+void ProcessManager::watchThreads(int pid, bool watch) {
+    runOnScanThread_([this, pid, watch] {
+        if (!watch) {
+            m_threadWatchPids.remove(pid);
+            m_threads.erase(pid);
+            return;
+        }
+
+        m_threadWatchPids.insert(pid);
+        if (!snapshot()) {
+            return;  // The first full scan reads them
+        }
+
+        m_activeFields = requiredFields_();
+        readSystemCpuTicks_();
+        readWatchedThreads_();
+        publishSnapshot_();
+        emit processesUpdated(snapshot());
+    });
+}
+
+/**
+ * @brief Read /proc/[PID]/task of every watched process; scan thread only
+ *
+ * Thread CPU% uses the same delta scheme as processes, with its own
+ * baselines since a main thread shares its process's (ID, start time).
+ */
+void ProcessManager::readWatchedThreads_() {
+    m_threads.clear();
+    if (m_threadWatchPids.isEmpty()) {
+        m_threadCpuSamples.clear();
+        return;
     }
 
-    // Use RAII for directory handle
-    std::unique_ptr<DIR, decltype(&closedir)> procDirGuard(procDir, closedir);
+    const bool collectCpu = m_activeFields.testFlag(ProcessField::Cpu);
+    QHash<ProcessKey, CpuSample> seenSamples;  // Only threads read now keep a baseline
 
-    struct dirent* entry;
-    while ((entry = readdir(procDir)) != nullptr) {
-        // Check if entry is a numeric directory (PID)
-        const char* name = entry->d_name;
-        if (!isValidProcessID_(std::atoi(name))) {
+    for (auto it = m_threadWatchPids.begin(); it != m_threadWatchPids.end();) {
+        const int pid = *it;
+        if (m_processTable.find(pid) == ProcessTable::INVALID_SLOT) {
+            it = m_threadWatchPids.erase(it);  // Exited
             continue;
         }
+        ++it;
+
+        if (!procfs::readThreadStats(m_procDirFd.get(), pid, m_taskIds, m_threadStats)) {
+            continue;
+        }
+
+        std::vector<ThreadInfo>& threads = m_threads[pid];
+        threads.reserve(m_threadStats.size());
+        for (const procfs::ThreadStat& thread : m_threadStats) {
+            ThreadInfo info;
+            info.tid = thread.tid;
+            info.name = QString::fromUtf8(thread.stat.comm);
+            info.state = readProcessState_(thread.stat);
+            info.processor = thread.stat.processor;
+
+            if (collectCpu) {
+                const ProcessKey key{thread.tid, thread.stat.startTime};
+                CpuSample sample = m_threadCpuSamples.value(key);
+                info.cpuPercent = cpuPercentSince_(sample, thread.stat.utime + thread.stat.stime);
+                seenSamples.insert(key, sample);
+            }
+            threads.push_back(std::move(info));
+        }
+    }
+
+    m_threadCpuSamples.swap(seenSamples);
+}
+
+/**
+ * @brief Re-read the processes queued by requestProcessRefresh(); scan thread only
+ */
+void ProcessManager::rereadProcesses_() {
+    const std::vector<int> pids = m_refreshCoordinator.takeProcesses();
+    if (pids.empty() || !snapshot()) {
+        return;  // Nothing to patch before the first full scan
+    }
+
+    m_activeFields = requiredFields_();
+    readSystemCpuTicks_();
+
+    for (const int pid : pids) {
+        const ProcessTable::Slot slot = m_processTable.find(pid);
+        if (slot == ProcessTable::INVALID_SLOT) {
+            continue;
+        }
+
+        ProcessSample sample;
+        sampleProcess_(pid, sample);
+        if (!sample.valid || sample.stat.startTime != m_processTable.startTime(slot)) {
+            m_processTable.remove(slot);  // Exited, or the PID already belongs to another process
+            continue;
+        }
+
+        updateSamplingTier_(pid, sample);
+        updateProcessRow_(slot, sample);
+    }
+
+    publishSnapshot_();
+    emit processesUpdated(snapshot());
+}
+
+/**
+ * @brief Read every process in /proc into m_processTable
+ * @return false if /proc could not be enumerated
+ */
+bool ProcessManager::scan_() {
+    // Enumerate all PIDs up front
+    if (!procfs::listProcessIds(m_procDirFd.get(), m_processIds)) {
+        qWarning() << "Failed to read /proc directory:" << strerror(errno);
+        return false;
+    }
+
+    // kernel.pid_max may have been raised since it was last read
+    if (!m_processIds.empty() && m_processIds.back() >= m_pidMax) {
+        m_pidMax = procfs::readPidMax();
+    }
+
+    beginScan_();
 
-        const int pid = std::atoi(name);
+    // Read /proc for every PID in parallel, then build results serially
+    sampleAllProcesses_();
+    applySamples_();
 
-        // Get process information
-        auto processInfo = getProcessInfo(pid);
-        if (processInfo.has_value()) {
-            processes.append(processInfo.value());
+    // Costs nothing unless the GUI shows the threads of some process
+    readWatchedThreads_();
+    return true;
+}
+
+/**
+ * @brief Apply queued requests and read the system-wide state a scan is measured against
+ */
+void ProcessManager::beginScan_() {
+    applyPendingRequests_();
+    m_activeFields = requiredFields_();
+
+    // One read of /proc/stat per scan gives the system-wide view and the time base of per-process CPU%
+    if (m_cpuCollector.sample()) {
+        m_cpuCount = m_cpuCollector.onlineCoreCount();
+        m_systemCpuTicks = m_cpuCollector.totalTimes().total();
+    }
+    if (!m_activeFields.testFlag(ProcessField::Cpu)) {
+        m_cpuSamples.clear();  // See readSystemCpuTicks_()
+    }
+}
+
+/**
+ * @brief Build m_processTable from m_samples and drop state of processes that are gone
+ */
+void ProcessManager::applySamples_() {
+    // PIDs are visited in ascending order, which keeps the table's slot order by PID
+    m_processTable.beginUpdate();
+    for (std::size_t i = 0; i < m_processIds.size(); ++i) {
+        const ProcessSample& sample = m_samples[i];
+        if (!sample.valid) {
+            continue;
         }
+
+        if (sample.fresh) {
+            updateSamplingTier_(m_processIds[i], sample);
+        }
+        updateProcessRow_(m_processTable.upsert({m_processIds[i], sample.stat.startTime}), sample);
     }
 
-    return processes;
+    // Enumeration is exact every tick, so exited processes are dropped here
+    m_processTable.endUpdate();
+    pruneSamplingStates_();
+    pruneExitedProcesses_();
+}
+
+/**
+ * @brief Run a full scan of given /proc/[PID]/stat contents instead of /proc
+ * @param pids Process IDs in ascending order, as listProcessIds() returns them
+ * @param stats Contents of each PID's stat file, parallel to pids
+ *
+ * Everything after the reads is the real scan path: sampling tiers, row
+ * updates, CPU baselines, memory history, pruning and publishing. Lets
+ * benchmarks measure that path at process counts no test host can run.
+ * Runs on the scan thread like requestRefresh() and emits processesUpdated().
+ */
+void ProcessManager::scanStatContents(std::vector<int> pids, std::vector<std::string> stats) {
+    runOnScanThread_([this, pids = std::move(pids), stats = std::move(stats)]() mutable {
+        m_processIds = std::move(pids);
+        beginScan_();
+
+        ++m_scanTick;
+        m_samples.resize(m_processIds.size());
+        for (std::size_t i = 0; i < m_processIds.size(); ++i) {
+            ProcessSample& sample = m_samples[i];
+            sample.valid = false;
+            sample.fresh = false;
+            if (i < stats.size() && isSampleDue_(m_processIds[i], sample)) {
+                sample.valid = procfs::parseStat(stats[i].data(), stats[i].size(), sample.stat);
+                sample.fresh = sample.valid;
+            }
+        }
+
+        applySamples_();
+        publishSnapshot_();
+        emit processesUpdated(snapshot());
+    });
+}
+
+/**
+ * @brief Copy the process table into a new immutable snapshot and publish it
+ *
+ * The table is copied once per scan; consumers then share the snapshot.
+ * Memory history stays with the manager and is not part of snapshots.
+ */
+void ProcessManager::publishSnapshot_() {
+    auto snapshot = std::make_shared<ProcessSnapshot>();
+    snapshot->timestamp = QDateTime::currentMSecsSinceEpoch();
+    snapshot->sequence = ++m_snapshotSequence;
+    snapshot->table = m_processTable;
+    snapshot->cpu = m_cpuCollector.usage();
+    snapshot->threads = m_threads;
+
+    std::atomic_store(&m_snapshot, ProcessSnapshotPtr(std::move(snapshot)));
 }
 
 /**
  * @brief Get information for a specific process
  * @param processID The process ID to query
- * @return Optional ProcessInfo structure
+ * @return The process's row in the latest snapshot, without memory history
  */
 std::optional<ProcessInfo> ProcessManager::getProcessInfo(int processID) {
     if (!isValidProcessID_(processID)) {
@@ -94,36 +471,417 @@ std::optional<ProcessInfo> ProcessManager::getProcessInfo(int processID) {
         return std::nullopt;
     }
 
-    const QString procPath = QString("/proc/%1").arg(processID);
-    if (!QDir(procPath).exists()) {
-        qDebug() << "Process" << processID << "no longer exists";
-        return std::nullopt;
+    if (const ProcessSnapshotPtr current = snapshot()) {
+        return current->find(processID);
     }
+    return std::nullopt;
+}
 
-    try {
-        const QString processName = readProcessName_(processID);
-        const double memoryMB = readProcessMemory_(processID);
-        const double cpuPercent = readProcessCpu_(processID);
-        const ProcessState state = readProcessState_(processID);
-        const int priority = readProcessPriority_(processID);
-
-        ProcessInfo processInfo(processID, processName, memoryMB, cpuPercent, state);
-        processInfo.priority = priority;
-        
-        // Update memory history and detect leaks
-        updateMemoryHistory_(processInfo);
-        processInfo.isMemoryLeech = detectMemoryLeak_(processInfo);
-        
-        if (processInfo.isMemoryLeech) {
-            const double growthMB = processInfo.memoryHistory.size() >= 2 ? 
-                processInfo.memoryMB - processInfo.memoryHistory.first().second : 0.0;
-            emit memoryLeakDetected(processID, processName, growthMB);
-        }
-
-        return processInfo;
-    } catch (const ProcessException& e) {
-        qWarning() << "Error reading process" << processID << ":" << e.what();
-        return std::nullopt;
+/**
+ * @brief Set which per-process fields are collected
+ * @param fields Fields the caller displays; fields needed by active detectors
+ *               (memory for leak detection, CPU and memory for focus mode) are
+ *               collected regardless
+ */
+void ProcessManager::setFieldMask(ProcessFields fields) {
+    QMutexLocker locker(&m_requestMutex);
+    const ProcessFields added = fields & ~m_fieldMask;
+    m_fieldMask = fields;
+
+    // Carried-over samples have no CPU baseline
+    if (added.testFlag(ProcessField::Cpu)) {
+        m_forceSampleAll = true;
+    }
+}
+
+/**
+ * @brief Field mask requested by the caller
+ */
+ProcessFields ProcessManager::fieldMask() const {
+    QMutexLocker locker(&m_requestMutex);
+    return m_fieldMask;
+}
+
+/**
+ * @brief Hand requests made from other threads since the last scan to the scheduler
+ */
+void ProcessManager::applyPendingRequests_() {
+    QMutexLocker locker(&m_requestMutex);
+    m_requestedFields = m_fieldMask;
+
+    if (m_forceSampleAll) {
+        for (auto& [pid, state] : m_samplingStates) {
+            state.forceSample = true;
+        }
+        m_forceSampleAll = false;
+    }
+
+    for (const int pid : m_pendingSamples) {
+        const auto it = m_samplingStates.find(pid);
+        if (it != m_samplingStates.end()) {
+            it->second.forceSample = true;
+        }
+    }
+    m_pendingSamples.clear();
+}
+
+/**
+ * @brief Effective field mask: the requested fields plus those the detectors depend on
+ */
+ProcessFields ProcessManager::requiredFields_() const {
+    ProcessFields fields = m_requestedFields | ProcessField::Memory;  // Leak detection always runs
+
+    if (m_focusModeEnabled) {
+        fields |= ProcessField::Cpu;  // Foreground and background heuristics
+    }
+
+    return fields;
+}
+
+/**
+ * @brief Get the descriptor cache shard that owns a PID
+ */
+procfs::ProcessFileCache& ProcessManager::fileCacheFor_(int pid) {
+    return *m_fileCaches[static_cast<std::size_t>(pid) % m_fileCaches.size()];
+}
+
+/**
+ * @brief Read the raw /proc data of one process
+ * @param pid The process ID to query
+ * @param sample Output; valid is false if the process vanished
+ *
+ * Safe to call concurrently for PIDs in different cache shards.
+ */
+void ProcessManager::sampleProcess_(int pid, ProcessSample& sample) {
+    sample.valid = false;
+
+    const std::optional<procfs::ProcessStat> stat = readProcessStat_(pid);
+    if (!stat.has_value()) {
+        qDebug() << "Process" << pid << "no longer exists";
+        return;
+    }
+
+    sample.stat = *stat;
+    sample.valid = true;
+    sample.fresh = true;
+}
+
+/**
+ * @brief Sample the PIDs in m_processIds that are due this tick
+ *
+ * Processes that are not due keep their previous sample (see
+ * isSampleDue_()). Results are written to m_samples at the PID's index,
+ * which keeps the merged output in PID order.
+ */
+void ProcessManager::sampleAllProcesses_() {
+    const std::size_t processCount = m_processIds.size();
+
+    ++m_scanTick;
+    m_samples.resize(processCount);
+    m_dueIndices.clear();
+    for (auto& cache : m_fileCaches) {
+        cache->beginScan();
+    }
+
+    for (std::size_t i = 0; i < processCount; ++i) {
+        const int pid = m_processIds[i];
+        ProcessSample& sample = m_samples[i];
+        sample.valid = false;
+        sample.fresh = false;
+
+        if (!isValidProcessID_(pid)) {
+            continue;
+        }
+
+        if (isSampleDue_(pid, sample)) {
+            m_dueIndices.push_back(static_cast<int>(i));
+        }
+    }
+
+    if (m_uringReader && !sampleAllProcessesUring_()) {
+        qWarning() << "io_uring scan failed, falling back to synchronous /proc reads";
+        m_uringReader.reset();
+        m_uringActive = false;
+    }
+    if (!m_uringReader) {
+        sampleDueProcessesSharded_();
+    }
+
+    // Release descriptors of processes that exited since the previous scan
+    for (auto& cache : m_fileCaches) {
+        cache->sweep();
+    }
+}
+
+/**
+ * @brief Read the due PIDs on the scan pool, one descriptor cache shard per thread
+ *
+ * Due PIDs are bucketed by cache shard so that each descriptor cache is
+ * only ever touched by one thread.
+ */
+void ProcessManager::sampleDueProcessesSharded_() {
+    const std::size_t shardCount = m_fileCaches.size();
+
+    for (auto& indices : m_shardIndices) {
+        indices.clear();
+    }
+    for (const int index : m_dueIndices) {
+        const int pid = m_processIds[static_cast<std::size_t>(index)];
+        m_shardIndices[static_cast<std::size_t>(pid) % shardCount].push_back(index);
+    }
+
+    // Small process counts are cheaper to scan on a single thread
+    const std::size_t workerCount = qBound<std::size_t>(
+        1, (m_dueIndices.size() + MIN_PROCESSES_PER_SCAN_THREAD - 1) / MIN_PROCESSES_PER_SCAN_THREAD, shardCount);
+
+    auto runWorker = [this, shardCount, workerCount](std::size_t worker) {
+        for (std::size_t shard = worker; shard < shardCount; shard += workerCount) {
+            for (const int index : m_shardIndices[shard]) {
+                sampleProcess_(m_processIds[static_cast<std::size_t>(index)],
+                               m_samples[static_cast<std::size_t>(index)]);
+            }
+        }
+    };
+
+    for (std::size_t worker = 1; worker < workerCount; ++worker) {
+        m_scanPool->start([runWorker, worker] { runWorker(worker); });
+    }
+    runWorker(0);
+    m_scanPool->waitForDone();
+}
+
+/**
+ * @brief Sample the due PIDs with batched io_uring reads
+ * @return false if the ring failed and the synchronous path must be used
+ *
+ * PIDs are processed in batches sized to fill the submission queue, with
+ * one reused buffer arena for the whole batch.
+ */
+bool ProcessManager::sampleAllProcessesUring_() {
+    const std::size_t dueCount = m_dueIndices.size();
+    const std::size_t batchSize = qMax<std::size_t>(1, m_uringReader->entries());
+
+    m_uringRequests.resize(batchSize);
+    m_uringBuffers.resize(batchSize * procfs::STAT_BUFFER_SIZE);
+
+    for (std::size_t batchStart = 0; batchStart < dueCount; batchStart += batchSize) {
+        const std::size_t batchLength = qMin(dueCount - batchStart, batchSize);
+
+        // Queue stat for every PID in the batch; the name comes from its comm field
+        for (std::size_t b = 0; b < batchLength; ++b) {
+            procfs::UringReader::Request& request = m_uringRequests[b];
+            request.pid = m_processIds[static_cast<std::size_t>(m_dueIndices[batchStart + b])];
+            request.file = procfs::ProcessFile::Stat;
+            request.buffer = m_uringBuffers.data() + b * procfs::STAT_BUFFER_SIZE;
+            request.capacity = procfs::STAT_BUFFER_SIZE;
+        }
+
+        if (!m_uringReader->readAll(m_procDirFd.get(), m_uringRequests.data(), batchLength)) {
+            return false;
+        }
+
+        // Requests are in batch order
+        for (std::size_t b = 0; b < batchLength; ++b) {
+            const procfs::UringReader::Request& stat = m_uringRequests[b];
+            ProcessSample& sample = m_samples[static_cast<std::size_t>(m_dueIndices[batchStart + b])];
+
+            if (stat.result <= 0 ||
+                !procfs::parseStat(stat.buffer, static_cast<std::size_t>(stat.result), sample.stat)) {
+                continue;  // Process exited during the batch
+            }
+
+            sample.valid = true;
+            sample.fresh = true;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decide whether a process has to be re-read this tick
+ * @param pid Process ID seen by this tick's enumeration
+ * @param sample Filled with the previous sample when the process is skipped
+ * @return true if /proc must be read for this process
+ *
+ * Hot processes (CPU or memory changed at their last sample) are read
+ * every tick, warm ones every m_coldSampleInterval / 2 ticks and cold ones
+ * every m_coldSampleInterval ticks. PIDs are staggered so cold reads are
+ * spread evenly over ticks rather than bunched together.
+ *
+ * The previous sample is only carried over while the process it was taken
+ * from is still alive, as checked on its cached stat descriptor. A PID
+ * without one (full cache, io_uring backend) is read every tick, so a
+ * reused PID never shows the exited process under a valid handle.
+ */
+bool ProcessManager::isSampleDue_(int pid, ProcessSample& sample) {
+    SamplingState& state = m_samplingStates[pid];
+    state.lastSeenTick = m_scanTick;
+
+    if (state.forceSample || !state.lastSample.valid) {
+        return true;
+    }
+
+    int interval = 1;
+    switch (state.tier) {
+    case SamplingTier::Hot:
+        interval = 1;
+        break;
+    case SamplingTier::Warm:
+        interval = qMax(1, m_coldSampleInterval / 2);
+        break;
+    case SamplingTier::Cold:
+        interval = m_coldSampleInterval;
+        break;
+    }
+
+    if ((m_scanTick + static_cast<quint64>(pid)) % static_cast<quint64>(interval) == 0) {
+        return true;
+    }
+
+    if (!fileCacheFor_(pid).retain(pid)) {
+        return true;  // Exited, possibly reused, or not cached: sample it now
+    }
+
+    sample = state.lastSample;
+    sample.fresh = false;
+    return false;
+}
+
+/**
+ * @brief Reclassify a freshly sampled process into a sampling tier
+ */
+void ProcessManager::updateSamplingTier_(int pid, const ProcessSample& sample) {
+    SamplingState& state = m_samplingStates[pid];
+    const ProcessSample& previous = state.lastSample;
+
+    // A different start time means the PID was reused; schedule the new process from scratch
+    const bool active = !previous.valid || sample.stat.startTime != previous.stat.startTime ||
+        (sample.stat.utime + sample.stat.stime) != (previous.stat.utime + previous.stat.stime) ||
+        sample.stat.rssPages != previous.stat.rssPages ||
+        sample.stat.state != previous.stat.state;
+
+    state.idleSamples = active ? 0 : state.idleSamples + 1;
+    if (state.idleSamples == 0) {
+        state.tier = SamplingTier::Hot;
+    } else if (state.idleSamples < COLD_AFTER_IDLE_SAMPLES) {
+        state.tier = SamplingTier::Warm;
+    } else {
+        state.tier = SamplingTier::Cold;
+    }
+
+    state.forceSample = false;
+    state.lastSample = sample;
+}
+
+/**
+ * @brief Drop sampling state of PIDs that this tick's enumeration did not see
+ */
+void ProcessManager::pruneSamplingStates_() {
+    for (auto it = m_samplingStates.begin(); it != m_samplingStates.end();) {
+        if (it->second.lastSeenTick != m_scanTick) {
+            it = m_samplingStates.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Drop per-process state of identities that are no longer in the process table
+ *
+ * A PID that was reused by a new process does not match its old identity,
+ * so the old process's history is dropped rather than inherited.
+ */
+void ProcessManager::pruneExitedProcesses_() {
+    for (auto it = m_processMemoryHistory.begin(); it != m_processMemoryHistory.end();) {
+        if (!m_processTable.contains(it.key())) {
+            it = m_processMemoryHistory.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = m_cpuSamples.begin(); it != m_cpuSamples.end();) {
+        if (!m_processTable.contains(it.key())) {
+            it = m_cpuSamples.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = m_focusAdjustedProcesses.begin(); it != m_focusAdjustedProcesses.end();) {
+        if (!m_processTable.contains(*it)) {
+            it = m_focusAdjustedProcesses.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Set how often idle processes are re-read
+ * @param ticks Cold processes are read every this many refreshes; 1 reads everything every tick
+ */
+void ProcessManager::setColdSampleInterval(int ticks) {
+    m_coldSampleInterval = qMax(1, ticks);
+}
+
+/**
+ * @brief Make sure a process is re-read on the next scan, e.g. after signalling it
+ *
+ * Callable from any thread; the request is applied when the next scan starts.
+ */
+void ProcessManager::forceSample_(int pid) {
+    QMutexLocker locker(&m_requestMutex);
+    m_pendingSamples.push_back(pid);
+}
+
+/**
+ * @brief Write a raw sample into its process table row and update leak tracking
+ *
+ * Runs on the scanning thread only, since it updates the memory history
+ * and emits signals. Fields outside m_activeFields keep their defaults.
+ * Memory history and leak detection only see samples read this tick.
+ */
+void ProcessManager::updateProcessRow_(ProcessTable::Slot slot, const ProcessSample& sample) {
+    const ProcessFields fields = m_activeFields;
+    const int pid = m_processTable.pid(slot);
+    const double memoryMB = fields.testFlag(ProcessField::Memory) ? readProcessMemory_(sample.stat) : 0.0;
+
+    // comm only changes on exec (or PR_SET_NAME); for everything else this is one comparison
+    m_processTable.setName(slot, sample.stat.comm, std::strlen(sample.stat.comm));
+    m_processTable.setParentPid(slot, sample.stat.ppid);
+    m_processTable.setMemoryMB(slot, memoryMB);
+    if (!fields.testFlag(ProcessField::Cpu)) {
+        m_processTable.setCpuPercent(slot, 0.0);
+    } else if (sample.fresh) {
+        // A carried-over sample keeps the CPU% of the interval it was read in
+        m_processTable.setCpuPercent(slot, readProcessCpu_(m_processTable.key(slot), sample.stat));
+    }
+    m_processTable.setState(slot, fields.testFlag(ProcessField::State) ? readProcessState_(sample.stat)
+                                                                       : ProcessState::Running);
+    m_processTable.setPriority(slot, fields.testFlag(ProcessField::Priority) ? readProcessPriority_(sample.stat) : 0);
+
+    if (!fields.testFlag(ProcessField::Memory)) {
+        m_processTable.setMemoryLeech(slot, false);
+        return;
+    }
+
+    // A carried-over sample would add a duplicate of an old reading; the row
+    // keeps the verdict of the last real one
+    if (!sample.fresh) {
+        return;
+    }
+
+    // Update memory history and detect leaks
+    const MemoryHistory& history = updateMemoryHistory_(m_processTable.key(slot), memoryMB);
+    const bool isMemoryLeech = detectMemoryLeak_(history);
+    m_processTable.setMemoryLeech(slot, isMemoryLeech);
+
+    if (isMemoryLeech) {
+        const double growthMB = history.size() >= 2 ? memoryMB - history.first().second : 0.0;
+        emit memoryLeakDetected(pid, m_processTable.name(slot), growthMB);
     }
 }
 
@@ -149,6 +907,7 @@ bool ProcessManager::terminateProcess(int processID, TerminationMethod method) {
 
     if (result == 0) {
         qInfo() << "Successfully sent signal" << signal << "to process" << processID;
+        forceSample_(processID);
         emit processTerminated(processID, true);
         return true;
     } else {
@@ -159,37 +918,43 @@ bool ProcessManager::terminateProcess(int processID, TerminationMethod method) {
 }
 
 /**
- * @brief Read process state from /proc/[PID]/stat
+ * @brief Read and parse /proc/[PID]/stat in a single pass
  * @param pid Process ID
- * @return ProcessState (Running or Suspended)
+ * @return Parsed stat record, or std::nullopt if the process is gone or the record is malformed
  */
-ProcessState ProcessManager::readProcessState_(int pid) const {
-    const QString statPath = QString("/proc/%1/stat").arg(pid);
-    QFile statFile(statPath);
-
-    if (!statFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return ProcessState::Running;  // Default to running if can't read
-    }
+std::optional<procfs::ProcessStat> ProcessManager::readProcessStat_(int pid) {
+    char buffer[procfs::STAT_BUFFER_SIZE];
+    procfs::ProcessStat stat;
+
+    // A second attempt is only needed when cached descriptors turn out to
+    // belong to an earlier process that had the same PID
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const ssize_t length = fileCacheFor_(pid).read(m_procDirFd.get(), pid, procfs::ProcessFile::Stat,
+                                                 buffer, sizeof(buffer));
+        if (length <= 0) {
+            return std::nullopt;
+        }
 
-    QTextStream stream(&statFile);
-    const QString line = stream.readLine();
+        if (!procfs::parseStat(buffer, static_cast<std::size_t>(length), stat)) {
+            return std::nullopt;
+        }
 
-    if (line.isEmpty()) {
-        return ProcessState::Running;
+        if (fileCacheFor_(pid).validateStartTime(pid, stat.startTime)) {
+            return stat;
+        }
     }
 
-    // Parse the stat line - process state is field 3 (after pid and comm)
-    // Format: pid (comm) state ...
-    const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-
-    if (parts.size() < 3) {
-        return ProcessState::Running;
-    }
+    return std::nullopt;
+}
 
+/**
+ * @brief Derive process state from a parsed stat record
+ * @param stat Parsed /proc/[PID]/stat record
+ * @return ProcessState (Running or Suspended)
+ */
+ProcessState ProcessManager::readProcessState_(const procfs::ProcessStat& stat) const {
     // State field: R=running, S=sleeping, D=disk sleep, T=stopped, Z=zombie, etc.
-    const QString state = parts[2];
-    
-    if (state == "T" || state == "t") {
+    if (stat.state == 'T' || stat.state == 't') {
         return ProcessState::Suspended;  // Process is stopped (SIGSTOP)
     }
 
@@ -211,10 +976,19 @@ bool ProcessManager::setPriority(int processID, int priority) {
     // Clamp priority to valid range
     priority = qBound(-20, priority, 19);
 
+    // Focus mode re-applies priorities every tick; only a real change needs a re-read.
+    // getpriority() can legitimately return -1, so errno tells failures apart
+    errno = 0;
+    const int currentPriority = getpriority(PRIO_PROCESS, processID);
+    const bool unchanged = errno == 0 && currentPriority == priority;
+
     const int result = setpriority(PRIO_PROCESS, processID, priority);
     
     if (result == 0) {
         qInfo() << "Successfully set priority" << priority << "for process" << processID;
+        if (!unchanged) {
+            forceSample_(processID);
+        }
         return true;
     } else {
         qWarning() << "Failed to set priority for process" << processID << ":" << strerror(errno);
@@ -224,69 +998,65 @@ bool ProcessManager::setPriority(int processID, int priority) {
 
 /**
  * @brief Update memory history for a process
- * @param processInfo Process information to update
+ * @param key Process identity
+ * @param memoryMB Memory usage sampled this tick
+ * @return The process's history, including this sample
+ *
+ * The ring buffer caps the history at MemoryHistory::CAPACITY, so this is O(1)
+ * apart from dropping samples that aged out of the leak window.
  */
-void ProcessManager::updateMemoryHistory_(ProcessInfo& processInfo) {
+const MemoryHistory& ProcessManager::updateMemoryHistory_(const ProcessKey& key, double memoryMB) {
     const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    
+
     // Get existing history for this process
-    auto& history = m_processMemoryHistory[processInfo.pid];
-    
-    // Add current memory usage to history
-    history.append(qMakePair(currentTime, processInfo.memoryMB));
-    
+    MemoryHistory& history = m_processMemoryHistory[key];
+
+    // Add current memory usage; a full buffer drops its oldest sample
+    history.append(currentTime, memoryMB);
+
     // Remove old entries (older than 1 minute)
-    while (!history.isEmpty() && 
-           (currentTime - history.first().first) > MEMORY_LEAK_TIME_WINDOW_MS) {
-        history.removeFirst();
-    }
-    
-    // Limit history size
-    while (history.size() > HISTORY_MAX_ENTRIES) {
-        history.removeFirst();
-    }
-    
-    // Copy history to process info
-    processInfo.memoryHistory = history;
+    history.removeOlderThan(currentTime - MEMORY_LEAK_TIME_WINDOW_MS);
+
+    return history;
 }
 
 /**
  * @brief Detect if a process is leaking memory
- * @param processInfo Process information to check
+ * @param history Memory history of the process
  * @return true if memory leak detected, false otherwise
  */
-bool ProcessManager::detectMemoryLeak_(const ProcessInfo& processInfo) const {
-    if (processInfo.memoryHistory.size() < 2) {
+bool ProcessManager::detectMemoryLeak_(const MemoryHistory& history) const {
+    if (history.size() < 2) {
         return false;  // Need at least 2 data points
     }
-    
-    const auto& history = processInfo.memoryHistory;
+
     const qint64 currentTime = history.last().first;
     const double currentMemory = history.last().second;
-    
+
     // Find memory usage from 1 minute ago (or closest available)
     double oldMemory = currentMemory;
     qint64 oldTime = currentTime;
-    
-    for (const auto& entry : history) {
+
+    for (int i = 0; i < history.size(); ++i) {
+        const MemoryHistory::Sample& entry = history.at(i);
         if ((currentTime - entry.first) >= MEMORY_LEAK_TIME_WINDOW_MS * 0.8) {  // 80% of window
             oldMemory = entry.second;
             oldTime = entry.first;
             break;
         }
     }
-    
+
     // Calculate memory growth
     const double memoryGrowthMB = currentMemory - oldMemory;
     const qint64 timeSpanMS = currentTime - oldTime;
-    
+
     // Check if growth exceeds threshold
     if (timeSpanMS > 0 && memoryGrowthMB > MEMORY_LEAK_THRESHOLD_MB) {
         // Normalize to 1-minute window
         const double normalizedGrowth = (memoryGrowthMB * MEMORY_LEAK_TIME_WINDOW_MS) / timeSpanMS;
         return normalizedGrowth > MEMORY_LEAK_THRESHOLD_MB;
     }
-    
+
     return false;
 }
 
@@ -303,86 +1073,84 @@ void ProcessManager::enableFocusMode(bool enabled) {
     
     if (enabled) {
         qInfo() << "Focus mode enabled";
-        optimizeForFocusedApp_();
+        runOnScanThread_([this] {
+            if (const ProcessSnapshotPtr current = snapshot()) {
+                optimizeForFocusedApp_(*current);
+            }
+        });
     } else {
         qInfo() << "Focus mode disabled";
-        // Reset all process priorities to normal
-        for (const auto& process : m_cachedProcesses) {
-            (void)setPriority(process.pid, 0);  // Normal priority (ignore result)
-        }
+        runOnScanThread_([this] { restoreFocusAdjustedPriorities_(); });
     }
     
     emit focusModeChanged(enabled);
 }
 
+/**
+ * @brief Reset the priorities focus mode changed, unless the PID now belongs to another process
+ */
+void ProcessManager::restoreFocusAdjustedPriorities_() {
+    for (const ProcessKey& key : m_focusAdjustedProcesses) {
+        if (m_processTable.contains(key)) {
+            (void)setPriority(key.pid, 0);  // Normal priority (ignore result)
+        }
+    }
+    m_focusAdjustedProcesses.clear();
+}
+
 /**
  * @brief Optimize system for focused application
  */
-void ProcessManager::optimizeForFocusedApp_() {
+void ProcessManager::optimizeForFocusedApp_(const ProcessSnapshot& snapshot) {
     if (!m_focusModeEnabled) {
         return;
     }
-    
-    const int focusedPID = getFocusedWindowPID_();
-    
-    for (const auto& process : m_cachedProcesses) {
-        if (process.pid == focusedPID) {
+
+    const ProcessTable& table = snapshot.table;
+    const int focusedPID = getFocusedWindowPID_(table);
+
+    for (const ProcessTable::Slot slot : table.liveSlots()) {
+        const int pid = table.pid(slot);
+        bool adjusted = false;
+        if (pid == focusedPID) {
             // Boost focused app priority
-            (void)setPriority(process.pid, -10);  // High priority (ignore result)
-        } else if (isBackgroundProcess_(process)) {
+            adjusted = setPriority(pid, -10);  // High priority
+        } else if (isBackgroundProcess_(table, slot)) {
             // Lower priority for background tasks
-            (void)setPriority(process.pid, 10);   // Low priority (ignore result)
+            adjusted = setPriority(pid, 10);   // Low priority
+        }
+
+        if (adjusted) {
+            m_focusAdjustedProcesses.insert(table.key(slot));
         }
     }
 }
 
 /**
- * @brief Read process priority from /proc/[PID]/stat
- * @param pid Process ID
+ * @brief Derive process priority from a parsed stat record
+ * @param stat Parsed /proc/[PID]/stat record
  * @return Process nice value
  */
-int ProcessManager::readProcessPriority_(int pid) const {
-    const QString statPath = QString("/proc/%1/stat").arg(pid);
-    QFile statFile(statPath);
-
-    if (!statFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return 0;  // Default priority
-    }
-
-    QTextStream stream(&statFile);
-    const QString line = stream.readLine();
-
-    if (line.isEmpty()) {
-        return 0;
-    }
-
-    // Parse the stat line - nice value is field 19
-    const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-
-    if (parts.size() < 19) {
-        return 0;
-    }
-
-    bool ok;
-    const int nice = parts[18].toInt(&ok);
-    return ok ? nice : 0;
+int ProcessManager::readProcessPriority_(const procfs::ProcessStat& stat) const {
+    return static_cast<int>(stat.nice);
 }
 
 /**
  * @brief Get PID of currently focused window (simplified implementation)
  * @return PID of focused process, or 0 if unable to determine
  */
-int ProcessManager::getFocusedWindowPID_() const {
+int ProcessManager::getFocusedWindowPID_(const ProcessTable& table) const {
     // Simplified implementation - in reality, this would use X11/Wayland APIs
     // For now, we'll use a heuristic: the process with highest CPU that's not a background task
     
     int focusedPID = 0;
     double highestCPU = 0.0;
     
-    for (const auto& process : m_cachedProcesses) {
-        if (!isBackgroundProcess_(process) && process.cpuPercent > highestCPU) {
-            highestCPU = process.cpuPercent;
-            focusedPID = process.pid;
+    for (const ProcessTable::Slot slot : table.liveSlots()) {
+        const double cpuPercent = table.cpuPercent(slot);
+        if (cpuPercent > highestCPU && !isBackgroundProcess_(table, slot)) {
+            highestCPU = cpuPercent;
+            focusedPID = table.pid(slot);
         }
     }
     
@@ -391,10 +1159,13 @@ int ProcessManager::getFocusedWindowPID_() const {
 
 /**
  * @brief Check if a process is a background task
- * @param processInfo Process to check
+ * @param table Process table holding the row
+ * @param slot Row to check
  * @return true if it's a background process
  */
-bool ProcessManager::isBackgroundProcess_(const ProcessInfo& processInfo) const {
+bool ProcessManager::isBackgroundProcess_(const ProcessTable& table, ProcessTable::Slot slot) const {
+    const QString& name = table.name(slot);
+
     // Common background processes/services
     const QStringList backgroundProcesses = {
         "systemd", "kthreadd", "ksoftirqd", "rcu_", "watchdog",
@@ -404,13 +1175,13 @@ bool ProcessManager::isBackgroundProcess_(const ProcessInfo& processInfo) const
     };
     
     for (const QString& bgProcess : backgroundProcesses) {
-        if (processInfo.name.contains(bgProcess, Qt::CaseInsensitive)) {
+        if (name.contains(bgProcess, Qt::CaseInsensitive)) {
             return true;
         }
     }
     
     // Low CPU usage processes are likely background
-    return processInfo.cpuPercent < 1.0 && processInfo.memoryMB > 50.0;
+    return table.cpuPercent(slot) < 1.0 && table.memoryMB(slot) > 50.0;
 }
 
 /**
@@ -433,6 +1204,7 @@ bool ProcessManager::suspendProcess(int processID) {
 
     if (result == 0) {
         qInfo() << "Successfully suspended process" << processID;
+        forceSample_(processID);
         return true;
     } else {
         qWarning() << "Failed to suspend process" << processID << ":" << strerror(errno);
@@ -460,6 +1232,7 @@ bool ProcessManager::resumeProcess(int processID) {
 
     if (result == 0) {
         qInfo() << "Successfully resumed process" << processID;
+        forceSample_(processID);
         return true;
     } else {
         qWarning() << "Failed to resume process" << processID << ":" << strerror(errno);
@@ -472,7 +1245,9 @@ bool ProcessManager::resumeProcess(int processID) {
  * @param interval Refresh interval in milliseconds
  */
 void ProcessManager::startPeriodicRefresh(std::chrono::milliseconds interval) {
-    m_refreshTimer->start(interval.count());
+    m_baseIntervalMs = static_cast<int>(interval.count());
+    applyRefreshInterval_(budgetedInterval_());
+    m_refreshTimer->start(m_effectiveIntervalMs);
 }
 
 /**
@@ -485,161 +1260,202 @@ void ProcessManager::stopPeriodicRefresh() {
 }
 
 /**
- * @brief Slot called when refresh timer times out
+ * @brief Limit the monitor's own CPU use to a share of one core
+ * @param percentOfCore Budget in percent of one core, e.g. 1.0; 0 refreshes at the requested interval
+ *
+ * The cost of each scan is measured as process CPU time, so scan workers and
+ * GUI work done while the scan runs count against the budget. The refresh
+ * interval is then stretched to cost / budget, but never below the interval
+ * passed to startPeriodicRefresh().
  */
-void ProcessManager::refreshProcessList_() {
-    const QVector<ProcessInfo> processes = getAllProcesses();
-    
-    // Update cached processes for focus mode
-    m_cachedProcesses = processes;
-    
-    // Optimize for focused app if focus mode is enabled
-    if (m_focusModeEnabled) {
-        optimizeForFocusedApp_();
-    }
-    
-    emit processesUpdated(processes);
+void ProcessManager::setCpuBudget(double percentOfCore) {
+    m_cpuBudgetPercent = qBound(0.0, percentOfCore, 100.0);
+    applyRefreshInterval_(budgetedInterval_());
 }
 
 /**
- * @brief Validate if a process ID is valid
- * @param pid Process ID to validate
- * @return true if valid, false otherwise
+ * @brief Fold the CPU time of one scan into the cost estimate and adapt the interval; scan thread only
  */
-bool ProcessManager::isValidProcessID_(int pid) const {
-    return pid > 0 && pid < 65536;
+void ProcessManager::recordScanCost_(double cpuTimeMs) {
+    const double previous = m_scanCostMs;
+    m_scanCostMs = previous > 0.0 ? previous + SCAN_COST_SMOOTHING * (cpuTimeMs - previous) : cpuTimeMs;
+
+    const int intervalMs = budgetedInterval_();
+    if (intervalMs != m_effectiveIntervalMs) {
+        // The timer belongs to the GUI thread
+        QMetaObject::invokeMethod(this, [this, intervalMs] { applyRefreshInterval_(intervalMs); },
+                                  Qt::QueuedConnection);
+    }
 }
 
 /**
- * @brief Read process name from /proc/[PID]/comm
- * @param pid Process ID
- * @return Process name as QString
+ * @brief Refresh interval that keeps the measured scan cost within the CPU budget
  */
-QString ProcessManager::readProcessName_(int pid) const {
-    const QString commPath = QString("/proc/%1/comm").arg(pid);
-    QFile commFile(commPath);
-
-    if (!commFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        throw ProcessException(QString("Cannot open %1").arg(commPath));
+int ProcessManager::budgetedInterval_() const {
+    const int baseIntervalMs = m_baseIntervalMs;
+    const double budgetPercent = m_cpuBudgetPercent;
+    if (budgetPercent <= 0.0) {
+        return baseIntervalMs;
     }
 
-    QTextStream stream(&commFile);
-    QString processName = stream.readLine().trimmed();
-
-    if (processName.isEmpty()) {
-        throw ProcessException("Empty process name");
-    }
-
-    return processName;
+    const double intervalMs = m_scanCostMs / (budgetPercent / 100.0);
+    const int stepped = static_cast<int>(std::ceil(intervalMs / REFRESH_INTERVAL_STEP_MS)) * REFRESH_INTERVAL_STEP_MS;
+    return qBound(baseIntervalMs, stepped, qMax(baseIntervalMs, MAX_REFRESH_INTERVAL_MS));
 }
 
 /**
- * @brief Read process memory usage from /proc/[PID]/status
- * @param pid Process ID
- * @return Memory usage in MB
+ * @brief Run the refresh timer at a new interval and announce it; GUI thread only
  */
-double ProcessManager::readProcessMemory_(int pid) const {
-    const QString statusPath = QString("/proc/%1/status").arg(pid);
-    QFile statusFile(statusPath);
-
-    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        throw ProcessException(QString("Cannot open %1").arg(statusPath));
+void ProcessManager::applyRefreshInterval_(int intervalMs) {
+    if (intervalMs == m_effectiveIntervalMs) {
+        return;
     }
 
-    QTextStream stream(&statusFile);
-    QString line;
-
-    while (stream.readLineInto(&line)) {
-        if (line.startsWith("VmRSS:")) {
-            // Extract memory value (format: "VmRSS:    1234 kB")
-            const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 3) {
-                bool ok;
-                const long kbValue = parts[1].toLong(&ok);
-                if (ok) {
-                    return kbValue / 1024.0;  // Convert KB to MB
-                }
-            }
-            break;
-        }
+    m_effectiveIntervalMs = intervalMs;
+    if (m_refreshTimer->isActive()) {
+        m_refreshTimer->setInterval(intervalMs);
     }
+    emit refreshIntervalChanged(intervalMs);
+}
 
-    return 0.0;  // No memory information available
+/**
+ * @brief Slot called when refresh timer times out
+ */
+void ProcessManager::refreshProcessList_() {
+    requestRefresh();
 }
 
 /**
- * @brief Read process CPU usage from /proc/[PID]/stat
- * @param pid Process ID
- * @return CPU usage percentage (0.0-100.0)
+ * @brief Validate if a process ID is valid
+ * @param pid Process ID to validate
+ * @return true if valid, false otherwise
  */
-double ProcessManager::readProcessCpu_(int pid) const {
-    const QString statPath = QString("/proc/%1/stat").arg(pid);
-    QFile statFile(statPath);
+bool ProcessManager::isValidProcessID_(int pid) const {
+    return pid > 0 && pid < m_pidMax;
+}
 
-    if (!statFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return 0.0;
+/**
+ * @brief Derive resident memory from a parsed stat record
+ * @param stat Parsed /proc/[PID]/stat record
+ * @return Memory usage in MB
+ *
+ * The stat rss field is the same counter that status reports as VmRSS,
+ * so the much more expensive status file is not needed for it.
+ */
+double ProcessManager::readProcessMemory_(const procfs::ProcessStat& stat) const {
+    if (stat.rssPages <= 0) {
+        return 0.0;  // No memory information available (e.g. kernel threads)
     }
 
-    QTextStream stream(&statFile);
-    const QString line = stream.readLine();
+    return static_cast<double>(stat.rssPages) * m_pageSize / (1024.0 * 1024.0);
+}
 
-    if (line.isEmpty()) {
-        return 0.0;
+/**
+ * @brief Read the full /proc/[PID]/status of a process for a detail view
+ * @param processID The process ID to query
+ * @return Contents of the status file, or std::nullopt if the process is gone
+ *
+ * status is expensive for the kernel to generate, so it is only read on demand
+ * and never during a scan.
+ */
+std::optional<QString> ProcessManager::getProcessDetails(int processID) const {
+    if (!isValidProcessID_(processID)) {
+        return std::nullopt;
     }
 
-    // Parse the stat line - CPU times are fields 14 (utime) and 15 (stime)
-    // Format: pid (comm) state ppid ... utime stime ...
-    const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+    const procfs::FileDescriptor pidDir = procfs::openProcessDir(m_procDirFd.get(), processID);
+    if (!pidDir.isValid()) {
+        return std::nullopt;
+    }
 
-    if (parts.size() < 16) {
-        return 0.0;
+    char buffer[procfs::STATUS_BUFFER_SIZE];
+    const ssize_t length = procfs::readFileAt(pidDir.get(), "status", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return std::nullopt;
     }
 
-    bool ok1, ok2;
-    const unsigned long utime = parts[13].toULong(&ok1);  // User time
-    const unsigned long stime = parts[14].toULong(&ok2);  // System time
+    return QString::fromUtf8(buffer, length);
+}
 
-    if (!ok1 || !ok2) {
-        return 0.0;
+/**
+ * @brief Check that a process is still the one a snapshot row was taken from
+ * @param key PID and start time of the row
+ * @return true if /proc/[PID]/stat exists now and reports the same start time
+ *
+ * Reads /proc directly rather than trusting the latest snapshot, so a PID
+ * reused since its last sample is not mistaken for the old process.
+ */
+bool ProcessManager::isProcessRunning(const ProcessKey& key) const {
+    if (!isValidProcessID_(key.pid)) {
+        return false;
     }
 
-    // Calculate total CPU time in clock ticks
-    const unsigned long totalTime = utime + stime;
+    char path[32];
+    char buffer[procfs::STAT_BUFFER_SIZE];
+    const ssize_t length = procfs::readFileAt(
+        m_procDirFd.get(), procfs::formatProcessPath(key.pid, "stat", path, sizeof(path)), buffer, sizeof(buffer));
 
-    // Get system uptime for percentage calculation
-    QFile uptimeFile("/proc/uptime");
-    if (!uptimeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return 0.0;
-    }
+    procfs::ProcessStat stat;
+    return length > 0 && procfs::parseStat(buffer, static_cast<std::size_t>(length), stat) &&
+        stat.startTime == key.startTime;
+}
 
-    QTextStream uptimeStream(&uptimeFile);
-    const QString uptimeLine = uptimeStream.readLine();
-    const QStringList uptimeParts = uptimeLine.split(' ', Qt::SkipEmptyParts);
+/**
+ * @brief Read the aggregate CPU total from /proc/stat as the time base of a targeted re-read
+ *
+ * Full scans take it from m_cpuCollector instead. Skipped when CPU is not
+ * collected; the baselines are dropped then, so the first interval after
+ * re-enabling it does not span the whole pause.
+ */
+void ProcessManager::readSystemCpuTicks_() {
+    if (!m_activeFields.testFlag(ProcessField::Cpu)) {
+        m_cpuSamples.clear();
+        return;
+    }
 
-    if (uptimeParts.isEmpty()) {
-        return 0.0;
+    procfs::CpuTimes times;
+    if (procfs::readSystemCpuTimes(times)) {
+        m_systemCpuTicks = times.total();
     }
+}
 
-    bool uptimeOk;
-    const double uptime = uptimeParts[0].toDouble(&uptimeOk);
+/**
+ * @brief CPU usage of a process since its previous sample
+ * @param key Process identity, so a reused PID starts from a fresh baseline
+ * @param stat Parsed /proc/[PID]/stat record
+ * @return CPU usage percentage over the interval; up to 100% per core, or
+ *         up to 100% in total if normalized per core. 0.0 for the first sample
+ *
+ * Process ticks and /proc/stat are both in USER_HZ, so their ratio needs no
+ * clock conversion. Each process keeps the system total of its own previous
+ * sample, which keeps the figure right for processes the tiered scheduler
+ * did not read every tick.
+ */
+double ProcessManager::readProcessCpu_(const ProcessKey& key, const procfs::ProcessStat& stat) {
+    return cpuPercentSince_(m_cpuSamples[key], stat.utime + stat.stime);
+}
 
-    if (!uptimeOk || uptime <= 0) {
-        return 0.0;
+/**
+ * @brief CPU% of a task between its previous sample and now, advancing the baseline
+ * @param previous Baseline of the process or thread; all zero if there is none yet
+ * @param ticks Its current utime + stime
+ */
+double ProcessManager::cpuPercentSince_(CpuSample& previous, unsigned long long ticks) const {
+    const bool hasBaseline = previous.systemTicks != 0;
+    const unsigned long long processDelta = ticks - previous.processTicks;
+    const unsigned long long systemDelta = m_systemCpuTicks - previous.systemTicks;
+    previous = {ticks, m_systemCpuTicks};
+
+    if (!hasBaseline || systemDelta == 0 || processDelta > ticks) {
+        return 0.0;  // No baseline yet, no time passed, or the counters went backwards
     }
 
-    // Get number of clock ticks per second
-    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
-    if (ticksPerSecond <= 0) {
-        return 0.0;
+    // systemDelta covers every core, so one busy core is a share of 1 / m_cpuCount
+    const double share = static_cast<double>(processDelta) / static_cast<double>(systemDelta);
+    if (m_cpuNormalizedPerCore) {
+        return qBound(0.0, share * 100.0, 100.0);
     }
-
-    // Calculate CPU usage percentage
-    // CPU% = (total_time / ticks_per_second) / uptime * 100
-    const double cpuSeconds = static_cast<double>(totalTime) / ticksPerSecond;
-    const double cpuPercent = (cpuSeconds / uptime) * 100.0;
-
-    // Clamp to reasonable range (0-100%)
-    return qBound(0.0, cpuPercent, 100.0);
+    return qBound(0.0, share * m_cpuCount * 100.0, m_cpuCount * 100.0);
 }
 
 /**
@@ -653,30 +1469,21 @@ bool ProcessManager::canKillProcess_(int pid) const {
         return true;
     }
 
-    // Check if process belongs to current user
-    const QString statusPath = QString("/proc/%1/status").arg(pid);
-    QFile statusFile(statusPath);
-
-    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    // Check if process belongs to current user. /proc/[PID] is normally owned
+    // by the process's effective UID, so one fstatat() settles the common case.
+    char name[16];
+    struct stat pidDirStat {};
+    if (fstatat(m_procDirFd.get(), procfs::formatPid(pid, name, sizeof(name)), &pidDirStat, 0) != 0) {
         return false;
     }
 
-    QTextStream stream(&statusFile);
-    QString line;
-
-    while (stream.readLineInto(&line)) {
-        if (line.startsWith("Uid:")) {
-            const QStringList parts = line.split('\t', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                bool ok;
-                const uid_t processUid = parts[1].toUInt(&ok);
-                if (ok && processUid == geteuid()) {
-                    return true;
-                }
-            }
-            break;
-        }
+    if (pidDirStat.st_uid == geteuid()) {
+        return true;
     }
 
-    return false;
-}
\ No newline at end of file
+    // The kernel reports the directory as root-owned for non-dumpable
+    // processes (ssh-agent, gpg-agent, anything after a setuid transition)
+    // even when they are ours. Signal 0 runs the kernel's own permission
+    // check without delivering anything.
+    return kill(pid, 0) == 0;
+}
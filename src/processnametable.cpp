@@ -0,0 +1,128 @@
+#include "processnametable.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Create a table holding only the empty name
+ */
+ProcessNameTable::ProcessNameTable()
+    : m_names(std::make_shared<std::vector<QString>>(1)) {
+    m_utf8Names.emplace_back();
+    m_refCounts.push_back(0);
+}
+
+/**
+ * @brief Make a read-only copy that shares the name list
+ */
+ProcessNameTable::ProcessNameTable(const ProcessNameTable& other)
+    : m_names(other.m_names) {
+}
+
+/**
+ * @brief Become a read-only copy that shares the name list
+ */
+ProcessNameTable& ProcessNameTable::operator=(const ProcessNameTable& other) {
+    if (this != &other) {
+        *this = ProcessNameTable(other);
+    }
+    return *this;
+}
+
+/**
+ * @brief Take a reference to a name, interning it if it is new
+ */
+ProcessNameTable::NameId ProcessNameTable::acquire(const char* data, std::size_t length) {
+    if (length == 0) {
+        return NO_NAME;
+    }
+
+    // fromRawData() looks the bytes up without copying them
+    const auto it = m_ids.constFind(QByteArray::fromRawData(data, static_cast<qsizetype>(length)));
+    if (it != m_ids.constEnd()) {
+        const NameId id = *it;
+        if (m_refCounts[id]++ == 0) {
+            --m_unusedCount;
+        }
+        return id;
+    }
+
+    NameId id;
+    const QByteArray utf8Name(data, static_cast<qsizetype>(length));
+    std::vector<QString>& names = writableNames_();
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        names[id] = QString::fromUtf8(utf8Name);
+        m_utf8Names[id] = utf8Name;
+    } else {
+        id = static_cast<NameId>(m_refCounts.size());
+        names.push_back(QString::fromUtf8(utf8Name));
+        m_utf8Names.push_back(utf8Name);
+        m_refCounts.push_back(0);
+    }
+
+    m_refCounts[id] = 1;
+    m_ids.insert(utf8Name, id);
+    return id;
+}
+
+/**
+ * @brief Drop a reference taken with acquire()
+ */
+void ProcessNameTable::release(NameId id) {
+    if (id == NO_NAME) {
+        return;
+    }
+
+    if (--m_refCounts[id] == 0) {
+        ++m_unusedCount;
+    }
+}
+
+/**
+ * @brief Whether an ID stands for exactly these UTF-8 bytes
+ */
+bool ProcessNameTable::equals(NameId id, const char* data, std::size_t length) const {
+    const QByteArray& utf8Name = m_utf8Names[id];
+    return static_cast<std::size_t>(utf8Name.size()) == length && std::memcmp(utf8Name.constData(), data, length) == 0;
+}
+
+/**
+ * @brief Forget unused names once they outnumber the names in use
+ *
+ * Amortized: a collection frees at least as many names as are in use, so
+ * the cost per released name stays constant.
+ */
+void ProcessNameTable::collectUnused() {
+    const std::size_t usedCount = m_refCounts.size() - m_freeIds.size() - m_unusedCount - 1;
+    if (m_unusedCount <= std::max(MIN_UNUSED_BEFORE_COLLECT, usedCount)) {
+        return;
+    }
+
+    std::vector<QString>& names = writableNames_();
+    for (NameId id = 1; id < m_refCounts.size(); ++id) {
+        QByteArray& utf8Name = m_utf8Names[id];
+        if (m_refCounts[id] != 0 || utf8Name.isNull()) {
+            continue;  // In use, or already recycled
+        }
+
+        m_ids.remove(utf8Name);
+        utf8Name = QByteArray();
+        names[id] = QString();
+        m_freeIds.push_back(id);
+    }
+    m_unusedCount = 0;
+}
+
+/**
+ * @brief The name list, replaced by a private copy first if a copy of the table shares it
+ *
+ * Copying the list copies QString handles, not characters.
+ */
+std::vector<QString>& ProcessNameTable::writableNames_() {
+    if (m_names.use_count() > 1) {
+        m_names = std::make_shared<std::vector<QString>>(*m_names);
+    }
+    return *m_names;
+}
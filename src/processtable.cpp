@@ -0,0 +1,185 @@
+#include "processtable.h"
+
+#include <algorithm>
+
+/**
+ * @brief Start a scan; rows not upserted before endUpdate() are removed
+ */
+void ProcessTable::beginUpdate() {
+    ++m_epoch;
+    m_previousOrder.swap(m_order);
+    m_order.clear();
+    m_mergeCursor = 0;
+}
+
+/**
+ * @brief Mark a process as live in the current scan, allocating a slot if it is new
+ */
+ProcessTable::Slot ProcessTable::upsert(const ProcessKey& key) {
+    if (!m_order.empty() && m_pids[m_order.back()] == key.pid) {
+        return m_order.back();  // Already upserted in this scan
+    }
+
+    // Both sequences are in PID order, so the previous row of this PID (if
+    // any) is at or after the cursor
+    while (m_mergeCursor < m_previousOrder.size() && m_pids[m_previousOrder[m_mergeCursor]] < key.pid) {
+        ++m_mergeCursor;
+    }
+
+    Slot slot;
+    if (m_mergeCursor < m_previousOrder.size() && m_pids[m_previousOrder[m_mergeCursor]] == key.pid) {
+        slot = m_previousOrder[m_mergeCursor];
+        if (m_startTimes[slot] != key.startTime) {
+            // PID reuse: same slot, but a new row as far as handles are concerned
+            ++m_generations[slot];
+            resetRow_(slot);
+            m_startTimes[slot] = key.startTime;
+        }
+    } else {
+        slot = allocate_();
+        m_pids[slot] = key.pid;
+        m_startTimes[slot] = key.startTime;
+    }
+
+    m_seenEpochs[slot] = m_epoch;
+    m_order.push_back(slot);
+    return slot;
+}
+
+/**
+ * @brief Free the slots of all processes that were not upserted since beginUpdate()
+ */
+void ProcessTable::endUpdate() {
+    for (const Slot slot : m_previousOrder) {
+        if (m_seenEpochs[slot] == m_epoch) {
+            continue;
+        }
+
+        // Invalidate outstanding handles and drop the name reference
+        ++m_generations[slot];
+        m_pids[slot] = 0;
+        clearName_(slot);
+        m_freeSlots.push_back(slot);
+    }
+    m_previousOrder.clear();
+
+    m_names.collectUnused();
+}
+
+/**
+ * @brief Remove one row outside of an update cycle, e.g. for a process seen to exit
+ *
+ * Linear in the number of live rows, since the PID order has to be kept.
+ */
+void ProcessTable::remove(Slot slot) {
+    const auto position = std::lower_bound(m_order.begin(), m_order.end(), m_pids[slot],
+                                           [this](Slot live, int pid) { return m_pids[live] < pid; });
+    if (m_pids[slot] == 0 || position == m_order.end() || *position != slot) {
+        return;  // Already free
+    }
+    m_order.erase(position);
+
+    ++m_generations[slot];
+    m_pids[slot] = 0;
+    clearName_(slot);
+    m_freeSlots.push_back(slot);
+}
+
+/**
+ * @brief Set the name from UTF-8 bytes; a no-op if it is unchanged
+ *
+ * A process keeps its name until it calls exec, so the common case is one
+ * short comparison against the name it already has.
+ */
+void ProcessTable::setName(Slot slot, const char* data, std::size_t length) {
+    if (m_names.equals(m_nameIds[slot], data, length)) {
+        return;
+    }
+
+    const NameId nameId = m_names.acquire(data, length);
+    m_names.release(m_nameIds[slot]);
+    m_nameIds[slot] = nameId;
+}
+
+/**
+ * @brief Slot of a live PID, or INVALID_SLOT
+ */
+ProcessTable::Slot ProcessTable::find(int pid) const {
+    const auto it = std::lower_bound(m_order.begin(), m_order.end(), pid,
+                                     [this](Slot live, int value) { return m_pids[live] < value; });
+    return it != m_order.end() && m_pids[*it] == pid ? *it : INVALID_SLOT;
+}
+
+/**
+ * @brief Whether the process with this exact identity is live
+ */
+bool ProcessTable::contains(const ProcessKey& key) const {
+    const Slot slot = find(key.pid);
+    return slot != INVALID_SLOT && m_startTimes[slot] == key.startTime;
+}
+
+/**
+ * @brief Check that a handle still refers to the process it was taken for
+ */
+bool ProcessTable::isValid(Handle handle) const {
+    return handle.slot < m_pids.size() && m_pids[handle.slot] != 0 &&
+           m_generations[handle.slot] == handle.generation;
+}
+
+/**
+ * @brief Row view of one process
+ */
+ProcessInfo ProcessTable::info(Slot slot) const {
+    ProcessInfo processInfo(m_pids[slot], name(slot), m_memoryMB[slot], m_cpuPercent[slot], m_states[slot]);
+    processInfo.startTime = m_startTimes[slot];
+    processInfo.priority = m_priorities[slot];
+    processInfo.isMemoryLeech = m_memoryLeech[slot] != 0;
+    return processInfo;
+}
+
+/**
+ * @brief Take a slot from the free list, or grow every column by one
+ */
+ProcessTable::Slot ProcessTable::allocate_() {
+    if (!m_freeSlots.empty()) {
+        const Slot slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        resetRow_(slot);
+        return slot;
+    }
+
+    const Slot slot = static_cast<Slot>(m_pids.size());
+    m_pids.push_back(0);
+    m_startTimes.push_back(0);
+    m_parentPids.push_back(0);
+    m_nameIds.push_back(ProcessNameTable::NO_NAME);
+    m_memoryMB.push_back(0.0);
+    m_cpuPercent.push_back(0.0);
+    m_states.push_back(ProcessState::Running);
+    m_priorities.push_back(0);
+    m_memoryLeech.push_back(0);
+    m_generations.push_back(0);
+    m_seenEpochs.push_back(0);
+    return slot;
+}
+
+/**
+ * @brief Reset the metric columns of a slot to their defaults
+ */
+void ProcessTable::resetRow_(Slot slot) {
+    m_parentPids[slot] = 0;
+    clearName_(slot);
+    m_memoryMB[slot] = 0.0;
+    m_cpuPercent[slot] = 0.0;
+    m_states[slot] = ProcessState::Running;
+    m_priorities[slot] = 0;
+    m_memoryLeech[slot] = 0;
+}
+
+/**
+ * @brief Drop a slot's reference to its name
+ */
+void ProcessTable::clearName_(Slot slot) {
+    m_names.release(m_nameIds[slot]);
+    m_nameIds[slot] = ProcessNameTable::NO_NAME;
+}
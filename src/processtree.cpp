@@ -0,0 +1,131 @@
+#include "processtree.h"
+
+#include <algorithm>
+
+/**
+ * @brief One radix digit of a process's parent PID, for the counting sort in build()
+ *
+ * Parent PIDs outside [0, PID_MAX_LIMIT) cannot belong to a process in the
+ * table; they are sorted as 0, which has no process either.
+ */
+std::size_t ProcessTree::parentKey_(const ProcessTable& table, Slot slot, int shift) {
+    const int parentPid = table.parentPid(slot);
+    const unsigned key = parentPid > 0 && parentPid < procfs::PID_MAX_LIMIT ? static_cast<unsigned>(parentPid) : 0u;
+    return (key >> shift) & (PARENT_PID_RADIX - 1);
+}
+
+/**
+ * @brief Rebuild the hierarchy and subtree totals from a table
+ */
+void ProcessTree::build(const ProcessTable& table) {
+    const std::size_t slotCount = table.slotCount();
+    const Slot none = ProcessTable::INVALID_SLOT;
+    m_parents.assign(slotCount, none);
+    m_firstChildren.assign(slotCount, none);
+    m_nextSiblings.assign(slotCount, none);
+    m_subtreeMemoryMB.assign(slotCount, 0.0);
+    m_subtreeCpuPercent.assign(slotCount, 0.0);
+    m_subtreeSizes.assign(slotCount, 0);
+    m_roots.clear();
+    m_preOrder.clear();
+    m_stack.clear();
+
+    const std::vector<Slot>& live = table.liveSlots();
+
+    // Order live slots by parent PID with two stable counting passes; siblings
+    // keep the table's PID order
+    m_byParent.assign(live.begin(), live.end());
+    m_sortScratch.resize(live.size());
+    for (int shift = 0; shift < 2 * PARENT_PID_RADIX_BITS; shift += PARENT_PID_RADIX_BITS) {
+        m_bucketStarts.assign(PARENT_PID_RADIX + 1, 0);
+        for (const Slot slot : m_byParent) {
+            ++m_bucketStarts[parentKey_(table, slot, shift) + 1];
+        }
+        for (std::size_t bucket = 1; bucket <= PARENT_PID_RADIX; ++bucket) {
+            m_bucketStarts[bucket] += m_bucketStarts[bucket - 1];
+        }
+        for (const Slot slot : m_byParent) {
+            m_sortScratch[m_bucketStarts[parentKey_(table, slot, shift)]++] = slot;
+        }
+        m_byParent.swap(m_sortScratch);
+    }
+
+    // Resolve parents by merging with the PID-ordered live slots. A parent must
+    // have started first: a PID that was reused between reading the child and
+    // the parent would otherwise adopt the child, and the strict order also
+    // rules out cycles.
+    auto candidate = live.begin();
+    for (const Slot slot : m_byParent) {
+        const int parentPid = table.parentPid(slot);
+        if (parentPid <= 0 || parentPid >= procfs::PID_MAX_LIMIT) {
+            continue;  // Sorted first, as 0
+        }
+        while (candidate != live.end() && table.pid(*candidate) < parentPid) {
+            ++candidate;
+        }
+        if (candidate == live.end()) {
+            break;
+        }
+
+        const Slot parent = *candidate;
+        if (table.pid(parent) != parentPid || parent == slot) {
+            continue;
+        }
+
+        const unsigned long long parentStart = table.startTime(parent);
+        const unsigned long long childStart = table.startTime(slot);
+        if (parentStart < childStart || (parentStart == childStart && table.pid(parent) < table.pid(slot))) {
+            m_parents[slot] = parent;
+        }
+    }
+
+    // Link children; prepending in descending PID order leaves every list ascending
+    for (auto it = live.rbegin(); it != live.rend(); ++it) {
+        const Slot slot = *it;
+        const Slot parent = m_parents[slot];
+        if (parent != none) {
+            m_nextSiblings[slot] = m_firstChildren[parent];
+            m_firstChildren[parent] = slot;
+        }
+    }
+
+    for (const Slot slot : live) {
+        if (m_parents[slot] == none) {
+            m_roots.push_back(slot);
+        }
+    }
+
+    // Pre-order traversal without recursion; trees can be thousands deep in theory
+    m_preOrder.reserve(live.size());
+    for (auto it = m_roots.rbegin(); it != m_roots.rend(); ++it) {
+        m_stack.push_back(*it);
+    }
+    while (!m_stack.empty()) {
+        const Slot slot = m_stack.back();
+        m_stack.pop_back();
+        m_preOrder.push_back(slot);
+
+        // Push children in reverse so the first child is visited first
+        const std::size_t firstPushed = m_stack.size();
+        for (Slot child = m_firstChildren[slot]; child != none; child = m_nextSiblings[child]) {
+            m_stack.push_back(child);
+        }
+        std::reverse(m_stack.begin() + static_cast<std::ptrdiff_t>(firstPushed), m_stack.end());
+    }
+
+    // Bottom-up: every child comes after its parent in pre-order, so walking it
+    // backwards finishes each subtree before adding it to the parent
+    for (auto it = m_preOrder.rbegin(); it != m_preOrder.rend(); ++it) {
+        const Slot slot = *it;
+        m_subtreeMemoryMB[slot] += table.memoryMB(slot);
+        m_subtreeCpuPercent[slot] += table.cpuPercent(slot);
+        m_subtreeSizes[slot] += 1;
+
+        const Slot parent = m_parents[slot];
+        if (parent != none) {
+            m_subtreeMemoryMB[parent] += m_subtreeMemoryMB[slot];
+            m_subtreeCpuPercent[parent] += m_subtreeCpuPercent[slot];
+            m_subtreeSizes[parent] += m_subtreeSizes[slot];
+        }
+    }
+}
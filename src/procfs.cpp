@@ -0,0 +1,695 @@
+#include "procfs.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+namespace procfs {
+
+namespace {
+
+/**
+ * @brief Skip spaces and tabs
+ */
+inline const char* skipBlanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+/**
+ * @brief Skip a single space-separated field and the blanks after it
+ */
+inline const char* skipField(const char* cursor, const char* end) {
+    while (cursor < end && *cursor != ' ') {
+        ++cursor;
+    }
+    return skipBlanks(cursor, end);
+}
+
+/**
+ * @brief Read everything available from fd into buffer and close it
+ */
+ssize_t readAndClose(int fd, char* buffer, std::size_t capacity) {
+    // /proc files are generated in one go, so a single read returns the
+    // complete record whenever the buffer is large enough
+    ssize_t length;
+    do {
+        length = ::read(fd, buffer, capacity - 1);
+    } while (length < 0 && errno == EINTR);
+
+    const int savedErrno = errno;
+    ::close(fd);
+    errno = savedErrno;
+
+    if (length < 0) {
+        return -1;
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Re-read a whole file from offset 0 with a single pread()
+ */
+ssize_t preadWhole(int fd, char* buffer, std::size_t capacity) {
+    ssize_t length;
+    do {
+        length = ::pread(fd, buffer, capacity - 1, 0);
+    } while (length < 0 && errno == EINTR);
+
+    if (length < 0) {
+        return -1;
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief File names inside /proc/[PID], indexed by ProcessFile
+ */
+constexpr const char* PROCESS_FILE_NAMES[] = {"stat"};
+static_assert(sizeof(PROCESS_FILE_NAMES) / sizeof(PROCESS_FILE_NAMES[0]) ==
+              static_cast<std::size_t>(ProcessFile::Count), "missing ProcessFile name");
+
+// getdents64 batch size; /proc entries are ~24-32 bytes each
+constexpr std::size_t DIRENT_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @brief Record layout returned by getdents64(2)
+ */
+struct LinuxDirent64 {
+    std::uint64_t d_ino;
+    std::int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+/**
+ * @brief Parse a /proc entry name as a PID
+ * @return The PID, or 0 if the name is not purely numeric
+ */
+inline int parsePidName(const char* name) {
+    // PIDs never start with '0', which also rejects "." and ".." quickly
+    if (static_cast<unsigned char>(name[0] - '1') > 8) {
+        return 0;
+    }
+
+    int pid = 0;
+    for (; *name; ++name) {
+        const unsigned digit = static_cast<unsigned char>(*name - '0');
+        if (digit > 9 || pid > (INT32_MAX - 9) / 10) {
+            return 0;
+        }
+        pid = pid * 10 + static_cast<int>(digit);
+    }
+    return pid;
+}
+
+// Descriptors left for the rest of the application (Qt, X11/Wayland, fonts, ...)
+constexpr rlim_t RESERVED_DESCRIPTORS = 256;
+// Upper bound when the limit is RLIM_INFINITY
+constexpr std::size_t MAX_CACHED_PROCESSES = 1 << 20;
+
+} // namespace
+
+FileDescriptor::~FileDescriptor() {
+    reset();
+}
+
+FileDescriptor& FileDescriptor::operator=(FileDescriptor&& other) noexcept {
+    if (this != &other) {
+        reset(other.release());
+    }
+    return *this;
+}
+
+void FileDescriptor::reset(int fd) noexcept {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_fd = fd;
+}
+
+/**
+ * @brief Format a PID as a NUL-terminated decimal string without allocating
+ */
+const char* formatPid(int pid, char* buffer, std::size_t capacity) {
+    char* cursor = buffer + capacity - 1;
+    *cursor = '\0';
+
+    unsigned int value = static_cast<unsigned int>(pid);
+    do {
+        *--cursor = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0 && cursor > buffer);
+
+    return cursor;
+}
+
+/**
+ * @brief Open /proc/[PID] relative to an open /proc directory
+ */
+FileDescriptor openProcessDir(int procDirFd, int pid) {
+    char name[16];
+    return FileDescriptor(::openat(procDirFd, formatPid(pid, name, sizeof(name)),
+                                   O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+}
+
+/**
+ * @brief File name inside /proc/[PID] of a ProcessFile
+ */
+const char* processFileName(ProcessFile file) {
+    return PROCESS_FILE_NAMES[static_cast<int>(file)];
+}
+
+/**
+ * @brief Enumerate process IDs in /proc with batched getdents64() calls
+ */
+bool listProcessIds(int procDirFd, std::vector<int>& pids) {
+    pids.clear();
+
+    if (::lseek(procDirFd, 0, SEEK_SET) < 0) {
+        return false;
+    }
+
+    alignas(LinuxDirent64) char buffer[DIRENT_BUFFER_SIZE];
+    for (;;) {
+        const long length = ::syscall(SYS_getdents64, procDirFd, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        for (long offset = 0; offset < length;) {
+            const auto* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+            offset += entry->d_reclen;
+
+            if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) {
+                continue;
+            }
+
+            const int pid = parsePidName(entry->d_name);
+            if (pid > 0) {
+                pids.push_back(pid);
+            }
+        }
+    }
+
+    // The kernel lists PIDs in ascending order; only sort if that ever changes
+    if (!std::is_sorted(pids.begin(), pids.end())) {
+        std::sort(pids.begin(), pids.end());
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read /proc/[PID]/task/[TID]/stat for every thread of a process
+ *
+ * The task directory has the same layout as /proc itself, so its thread IDs
+ * are enumerated the same way as PIDs.
+ */
+bool readThreadStats(int procDirFd, int pid, std::vector<int>& tids, std::vector<ThreadStat>& threads) {
+    threads.clear();
+
+    char path[32];
+    const FileDescriptor taskDir(::openat(procDirFd, formatProcessPath(pid, "task", path, sizeof(path)),
+                                          O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!taskDir.isValid() || !listProcessIds(taskDir.get(), tids)) {
+        return false;
+    }
+
+    threads.reserve(tids.size());
+    char buffer[STAT_BUFFER_SIZE];
+    for (const int tid : tids) {
+        const ssize_t length = readFileAt(taskDir.get(), formatProcessPath(tid, "stat", path, sizeof(path)),
+                                          buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;  // Exited since the directory was listed
+        }
+
+        ThreadStat thread;
+        thread.tid = tid;
+        if (parseStat(buffer, static_cast<std::size_t>(length), thread.stat)) {
+            threads.push_back(thread);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Read a whole file relative to a directory descriptor with a single read()
+ */
+ssize_t readFileAt(int dirFd, const char* name, char* buffer, std::size_t capacity) {
+    const int fd = ::openat(dirFd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    return readAndClose(fd, buffer, capacity);
+}
+
+/**
+ * @brief Read a whole /proc file into a fixed buffer with a single read()
+ */
+ssize_t readFile(const char* path, char* buffer, std::size_t capacity) {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    return readAndClose(fd, buffer, capacity);
+}
+
+/**
+ * @brief Read kernel.pid_max from /proc/sys/kernel/pid_max
+ */
+int readPidMax() {
+    char buffer[32];
+    const ssize_t length = readFile("/proc/sys/kernel/pid_max", buffer, sizeof(buffer));
+    if (length <= 0) {
+        return PID_MAX_LIMIT;
+    }
+
+    const char* cursor = buffer;
+    unsigned long long value = 0;
+    if (!parseUnsigned(cursor, buffer + length, value) || value < 2 ||
+        value > static_cast<unsigned long long>(PID_MAX_LIMIT)) {
+        return PID_MAX_LIMIT;
+    }
+    return static_cast<int>(value);
+}
+
+/**
+ * @brief Read the aggregate "cpu" line of /proc/stat
+ */
+bool readSystemCpuTimes(CpuTimes& times) {
+    // The aggregate line comes first; a short read is enough
+    char buffer[256];
+    const ssize_t length = readFile("/proc/stat", buffer, sizeof(buffer));
+    if (length <= 0 || std::strncmp(buffer, "cpu ", 4) != 0) {
+        return false;
+    }
+
+    const char* cursor = buffer + 3;
+    return parseCpuTimes(cursor, buffer + length, times);
+}
+
+/**
+ * @brief Parse the "cpu" lines at the top of /proc/stat
+ *
+ * Stops at the first line that is not a "cpu" line, so a buffer that cuts
+ * off the (long) interrupt counters that follow is fine; complete tells
+ * the caller whether every "cpu" line was in the buffer.
+ */
+bool parseCpuLines(const char* data, std::size_t length, CpuTimes& total, std::vector<CpuTimes>& cores,
+                   bool& complete) {
+    const char* cursor = data;
+    const char* const end = data + length;
+    bool haveTotal = false;
+    cores.clear();
+    complete = false;
+
+    // "intr" always follows the "cpu" lines; reaching any other line proves they all fit
+    while (end - cursor > 3) {
+        if (std::strncmp(cursor, "cpu", 3) != 0) {
+            complete = true;
+            break;
+        }
+
+        cursor += 3;
+        const char* const lineEnd = std::find(cursor, end, '\n');
+        if (lineEnd == end) {
+            break;  // Truncated line
+        }
+
+        if (*cursor == ' ') {
+            haveTotal = parseCpuTimes(cursor, lineEnd, total);
+        } else {
+            unsigned long long cpu = 0;
+            CpuTimes times;
+            if (parseUnsigned(cursor, lineEnd, cpu) && parseCpuTimes(cursor, lineEnd, times)) {
+                if (cpu >= cores.size()) {
+                    cores.resize(cpu + 1);
+                }
+                cores[cpu] = times;
+            }
+        }
+        cursor = lineEnd + 1;
+    }
+    return haveTotal;
+}
+
+/**
+ * @brief Parse the counters following the label of a "cpu" line of /proc/stat
+ *
+ * Older kernels lack the trailing columns; those are left at zero.
+ */
+bool parseCpuTimes(const char*& cursor, const char* end, CpuTimes& times) {
+    unsigned long long* const fields[] = {&times.user, &times.nice, &times.system, &times.idle,
+                                          &times.iowait, &times.irq, &times.softirq, &times.steal};
+    times = CpuTimes();
+
+    std::size_t parsed = 0;
+    for (unsigned long long* field : fields) {
+        if (!parseUnsigned(cursor, end, *field)) {
+            break;
+        }
+        ++parsed;
+    }
+    return parsed >= 4;
+}
+
+/**
+ * @brief Parse an unsigned decimal integer, skipping leading blanks
+ */
+bool parseUnsigned(const char*& cursor, const char* end, unsigned long long& value) {
+    const char* p = skipBlanks(cursor, end);
+    const char* const digitsStart = p;
+
+    unsigned long long result = 0;
+    while (p < end && static_cast<unsigned char>(*p - '0') < 10) {
+        result = result * 10 + static_cast<unsigned>(*p - '0');
+        ++p;
+    }
+
+    if (p == digitsStart) {
+        return false;
+    }
+
+    value = result;
+    cursor = p;
+    return true;
+}
+
+/**
+ * @brief Parse an optionally negative decimal integer, skipping leading blanks
+ */
+bool parseSigned(const char*& cursor, const char* end, long long& value) {
+    const char* p = skipBlanks(cursor, end);
+    const bool negative = (p < end && *p == '-');
+    if (negative) {
+        ++p;
+    }
+
+    unsigned long long magnitude = 0;
+    if (!parseUnsigned(p, end, magnitude)) {
+        return false;
+    }
+
+    value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+    cursor = p;
+    return true;
+}
+
+/**
+ * @brief Parse the contents of /proc/[PID]/stat
+ */
+bool parseStat(const char* data, std::size_t length, ProcessStat& stat) {
+    const char* const end = data + length;
+
+    // Format: pid (comm) state ppid ...
+    // comm may contain spaces and ')' itself, so it spans from the first '(' to the last ')'
+    const char* commStart = static_cast<const char*>(std::memchr(data, '(', length));
+    const char* commEnd = end;
+    while (commEnd > data && *(commEnd - 1) != ')') {
+        --commEnd;
+    }
+    if (!commStart || commEnd <= commStart + 1) {
+        return false;
+    }
+    --commEnd;  // Point at the closing ')'
+
+    std::size_t commLength = static_cast<std::size_t>(commEnd - commStart - 1);
+    if (commLength >= COMM_MAX_LENGTH) {
+        commLength = COMM_MAX_LENGTH - 1;
+    }
+    std::memcpy(stat.comm, commStart + 1, commLength);
+    stat.comm[commLength] = '\0';
+
+    const char* cursor = skipBlanks(commEnd + 1, end);
+    if (cursor >= end) {
+        return false;
+    }
+
+    // Walk fields 3..39 in order, only converting the ones we keep
+    stat.state = *cursor;
+    cursor = skipField(cursor, end);
+
+    long long signedValue = 0;
+    unsigned long long unsignedValue = 0;
+    int lastField = 3;
+    for (int field = 4; field <= 39 && cursor < end; ++field) {
+        switch (field) {
+        case 4:
+            if (!parseSigned(cursor, end, signedValue)) return false;
+            stat.ppid = static_cast<int>(signedValue);
+            break;
+        case 14:
+            if (!parseUnsigned(cursor, end, stat.utime)) return false;
+            break;
+        case 15:
+            if (!parseUnsigned(cursor, end, stat.stime)) return false;
+            break;
+        case 18:
+            if (!parseSigned(cursor, end, signedValue)) return false;
+            stat.priority = static_cast<long>(signedValue);
+            break;
+        case 19:
+            if (!parseSigned(cursor, end, signedValue)) return false;
+            stat.nice = static_cast<long>(signedValue);
+            break;
+        case 20:
+            if (!parseSigned(cursor, end, signedValue)) return false;
+            stat.numThreads = static_cast<long>(signedValue);
+            break;
+        case 22:
+            if (!parseUnsigned(cursor, end, stat.startTime)) return false;
+            break;
+        case 24:
+            if (!parseSigned(cursor, end, signedValue)) return false;
+            stat.rssPages = static_cast<long>(signedValue);
+            break;
+        case 39:
+            if (!parseUnsigned(cursor, end, unsignedValue)) return false;
+            stat.processor = static_cast<int>(unsignedValue);
+            break;
+        default:
+            break;
+        }
+        cursor = skipField(cursor, end);
+        lastField = field;
+    }
+
+    // Everything up to rss is required; processor is optional on old kernels
+    return lastField >= 24;
+}
+
+/**
+ * @brief Format "<pid>/<name>" for openat() relative to /proc without allocating
+ */
+const char* formatProcessPath(int pid, const char* name, char* buffer, std::size_t capacity) {
+    char pidBuffer[16];
+    const char* digits = formatPid(pid, pidBuffer, sizeof(pidBuffer));
+
+    std::size_t length = 0;
+    for (const char* part : {digits, "/", name}) {
+        while (*part && length + 1 < capacity) {
+            buffer[length++] = *part++;
+        }
+    }
+    buffer[length] = '\0';
+    return buffer;
+}
+
+ProcessFileCache::ProcessFileCache(std::size_t capacity)
+    : m_capacity(capacity)
+    , m_scanGeneration(0) {
+}
+
+/**
+ * @brief Number of processes that fit in the current RLIMIT_NOFILE soft limit
+ */
+std::size_t ProcessFileCache::defaultCapacity() {
+    struct rlimit limit {};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 0;
+    }
+
+    if (limit.rlim_cur == RLIM_INFINITY) {
+        return MAX_CACHED_PROCESSES;
+    }
+
+    if (limit.rlim_cur <= RESERVED_DESCRIPTORS) {
+        return 0;
+    }
+
+    const std::size_t perProcess = static_cast<std::size_t>(ProcessFile::Count);
+    const std::size_t available = static_cast<std::size_t>(limit.rlim_cur - RESERVED_DESCRIPTORS);
+    return available / perProcess < MAX_CACHED_PROCESSES ? available / perProcess : MAX_CACHED_PROCESSES;
+}
+
+/**
+ * @brief Raise the RLIMIT_NOFILE soft limit to the hard limit
+ */
+void ProcessFileCache::raiseDescriptorLimit() {
+    struct rlimit limit {};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &limit);  // Best effort; the cache adapts to whatever we get
+    }
+}
+
+/**
+ * @brief Open all cached files of a process, or return null if the cache is full or disabled
+ *
+ * A full cache does not admit new PIDs: evicting the least recently used
+ * entry for every miss would make a PID-ordered scan of more processes
+ * than the capacity close and reopen every file on every scan. Room is
+ * made by sweep() dropping PIDs that have exited.
+ */
+ProcessFileCache::Entry* ProcessFileCache::open_(int procDirFd, int pid) {
+    if (m_entries.size() >= m_capacity) {
+        return nullptr;
+    }
+
+    Entry entry;
+    for (int i = 0; i < static_cast<int>(ProcessFile::Count); ++i) {
+        char path[32];
+        entry.files[i].reset(::openat(procDirFd, formatProcessPath(pid, PROCESS_FILE_NAMES[i], path, sizeof(path)),
+                                      O_RDONLY | O_CLOEXEC));
+        if (!entry.files[i].isValid()) {
+            return nullptr;
+        }
+    }
+
+    m_lru.push_front(pid);
+    entry.lruPosition = m_lru.begin();
+    return &m_entries.emplace(pid, std::move(entry)).first->second;
+}
+
+/**
+ * @brief Read a whole per-process file, reusing a cached descriptor when possible
+ */
+ssize_t ProcessFileCache::read(int procDirFd, int pid, ProcessFile file, char* buffer, std::size_t capacity) {
+    auto it = m_entries.find(pid);
+    Entry* entry = (it != m_entries.end()) ? &it->second : nullptr;
+
+    if (entry) {
+        const ssize_t length = preadWhole(entry->files[static_cast<int>(file)].get(), buffer, capacity);
+        if (length > 0) {
+            entry->scanGeneration = m_scanGeneration;
+            m_lru.splice(m_lru.begin(), m_lru, entry->lruPosition);
+            return length;
+        }
+
+        // ESRCH or EOF: the process behind these descriptors is gone. The PID
+        // may already belong to a new process, so fall through and reopen.
+        evict(pid);
+    }
+
+    entry = open_(procDirFd, pid);
+    if (!entry) {
+        // Cache full or disabled, or the process is gone: a single openat/read/close
+        char path[32];
+        const ssize_t length = readFileAt(
+            procDirFd, formatProcessPath(pid, PROCESS_FILE_NAMES[static_cast<int>(file)], path, sizeof(path)),
+            buffer, capacity);
+        return length > 0 ? length : -1;
+    }
+
+    entry->scanGeneration = m_scanGeneration;
+    const ssize_t length = preadWhole(entry->files[static_cast<int>(file)].get(), buffer, capacity);
+    if (length <= 0) {
+        evict(pid);
+        return -1;
+    }
+    return length;
+}
+
+/**
+ * @brief Record the start time of the process behind a cached PID
+ */
+bool ProcessFileCache::validateStartTime(int pid, unsigned long long startTime) {
+    auto it = m_entries.find(pid);
+    if (it == m_entries.end()) {
+        return true;
+    }
+
+    Entry& entry = it->second;
+    if (entry.startTime != 0 && entry.startTime != startTime) {
+        evict(pid);
+        return false;
+    }
+
+    entry.startTime = startTime;
+    return true;
+}
+
+/**
+ * @brief Keep a live PID's descriptors through sweep() without parsing them
+ */
+bool ProcessFileCache::retain(int pid) {
+    auto it = m_entries.find(pid);
+    if (it == m_entries.end()) {
+        return false;
+    }
+
+    // A one-byte pread fails with ESRCH (or hits EOF) once the process the
+    // descriptor was opened for has exited, even if the PID was reused
+    Entry& entry = it->second;
+    char byte;
+    if (::pread(entry.files[static_cast<int>(ProcessFile::Stat)].get(), &byte, 1, 0) != 1) {
+        evict(pid);
+        return false;
+    }
+
+    entry.scanGeneration = m_scanGeneration;
+    m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+    return true;
+}
+
+/**
+ * @brief Close all descriptors held for a PID
+ */
+void ProcessFileCache::evict(int pid) {
+    auto it = m_entries.find(pid);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    m_lru.erase(it->second.lruPosition);
+    m_entries.erase(it);
+}
+
+/**
+ * @brief Evict every entry that was not read since beginScan()
+ */
+void ProcessFileCache::sweep() {
+    // Entries read during this scan were moved to the front, so stale ones
+    // are exactly the tail of the LRU list
+    while (!m_lru.empty()) {
+        const auto it = m_entries.find(m_lru.back());
+        if (it->second.scanGeneration == m_scanGeneration) {
+            break;
+        }
+        m_lru.pop_back();
+        m_entries.erase(it);
+    }
+}
+
+} // namespace procfs
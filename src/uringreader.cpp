@@ -0,0 +1,275 @@
+#include "uringreader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace procfs {
+
+namespace {
+
+inline int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+inline int ioUringRegister(int ringFd, unsigned opcode, void* arg, unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+}
+
+/**
+ * @brief Check that the kernel implements every opcode the reader needs
+ */
+bool supportsRequiredOps(int ringFd) {
+    constexpr unsigned PROBE_OPS = 256;
+    alignas(io_uring_probe) unsigned char storage[sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op)] = {};
+    auto* probe = reinterpret_cast<io_uring_probe*>(storage);
+
+    if (ioUringRegister(ringFd, IORING_REGISTER_PROBE, probe, PROBE_OPS) < 0) {
+        return false;  // Probing itself needs 5.6, as do the opcodes below
+    }
+
+    for (const unsigned op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE}) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Create a reader if the kernel supports io_uring with openat/read/close
+ */
+std::unique_ptr<UringReader> UringReader::create(unsigned entries) {
+    std::unique_ptr<UringReader> reader(new UringReader());
+    if (!reader->setup_(entries)) {
+        return nullptr;
+    }
+    return reader;
+}
+
+UringReader::~UringReader() {
+    if (m_sqes) {
+        ::munmap(m_sqes, m_sqesSize);
+    }
+    if (m_cqRing && m_cqRing != m_sqRing) {
+        ::munmap(m_cqRing, m_cqRingSize);
+    }
+    if (m_sqRing) {
+        ::munmap(m_sqRing, m_sqRingSize);
+    }
+    if (m_ringFd >= 0) {
+        ::close(m_ringFd);
+    }
+}
+
+/**
+ * @brief Create the ring and map its submission/completion queues
+ */
+bool UringReader::setup_(unsigned entries) {
+    io_uring_params params {};
+    m_ringFd = ioUringSetup(entries, &params);
+    if (m_ringFd < 0) {
+        return false;  // ENOSYS, or EPERM when disabled via kernel.io_uring_disabled
+    }
+
+    if (!supportsRequiredOps(m_ringFd)) {
+        return false;
+    }
+
+    m_entries = params.sq_entries;
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        m_sqRingSize = m_cqRingSize = (m_sqRingSize > m_cqRingSize) ? m_sqRingSize : m_cqRingSize;
+    }
+
+    m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_ringFd, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED) {
+        m_sqRing = nullptr;
+        return false;
+    }
+
+    if (singleMmap) {
+        m_cqRing = m_sqRing;
+    } else {
+        m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_ringFd, IORING_OFF_CQ_RING);
+        if (m_cqRing == MAP_FAILED) {
+            m_cqRing = nullptr;
+            return false;
+        }
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    m_ringFd, IORING_OFF_SQES);
+    if (m_sqes == MAP_FAILED) {
+        m_sqes = nullptr;
+        return false;
+    }
+
+    auto* sq = static_cast<unsigned char*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    auto* cq = static_cast<unsigned char*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = cq + params.cq_off.cqes;
+
+    return true;
+}
+
+/**
+ * @brief Open, read and close every request relative to /proc
+ */
+bool UringReader::readAll(int procDirFd, Request* requests, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        Request& request = requests[i];
+        request.result = -1;
+        request.fd = -1;
+
+        formatProcessPath(request.pid, processFileName(request.file), request.path, sizeof(request.path));
+    }
+
+    // Closes run even if reading failed so opened descriptors are not leaked
+    const bool ok = runPhase_(Phase::Open, requests, count, procDirFd) &&
+                    runPhase_(Phase::Read, requests, count, procDirFd);
+    return runPhase_(Phase::Close, requests, count, procDirFd) && ok;
+}
+
+/**
+ * @brief Queue one operation per applicable request, submitting whenever the ring fills
+ */
+bool UringReader::runPhase_(Phase phase, Request* requests, std::size_t count, int procDirFd) {
+    auto* sqes = static_cast<io_uring_sqe*>(m_sqes);
+    auto* cqes = static_cast<io_uring_cqe*>(m_cqes);
+
+    std::size_t next = 0;
+    while (next < count) {
+        // Fill the submission queue
+        unsigned tail = *m_sqTail;
+        unsigned queued = 0;
+        for (; next < count && queued < m_entries; ++next) {
+            Request& request = requests[next];
+            if (phase != Phase::Open && request.fd < 0) {
+                continue;
+            }
+
+            const unsigned index = tail & *m_sqMask;
+            io_uring_sqe* sqe = &sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->user_data = next;
+
+            switch (phase) {
+            case Phase::Open:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = procDirFd;
+                sqe->addr = reinterpret_cast<unsigned long>(request.path);
+                sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                break;
+            case Phase::Read:
+                sqe->opcode = IORING_OP_READ;
+                sqe->fd = request.fd;
+                sqe->addr = reinterpret_cast<unsigned long>(request.buffer);
+                sqe->len = static_cast<unsigned>(request.capacity - 1);
+                sqe->off = 0;
+                break;
+            case Phase::Close:
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = request.fd;
+                break;
+            }
+
+            m_sqArray[index] = index;
+            ++tail;
+            ++queued;
+        }
+
+        if (queued == 0) {
+            break;
+        }
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+        // Submit and reap exactly the completions for this batch
+        if (!submitAndWait_(queued)) {
+            return false;
+        }
+
+        unsigned completed = 0;
+        while (completed < queued) {
+            unsigned head = *m_cqHead;
+            const unsigned cqTail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            if (head == cqTail) {
+                if (ioUringEnter(m_ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                    return false;
+                }
+                continue;
+            }
+
+            for (; head != cqTail; ++head, ++completed) {
+                const io_uring_cqe& cqe = cqes[head & *m_cqMask];
+                Request& request = requests[cqe.user_data];
+
+                switch (phase) {
+                case Phase::Open:
+                    request.fd = cqe.res;  // Negative errno on failure
+                    if (request.fd < 0) {
+                        request.fd = -1;
+                    }
+                    break;
+                case Phase::Read:
+                    if (cqe.res > 0) {
+                        request.result = cqe.res;
+                        request.buffer[cqe.res] = '\0';
+                    }
+                    break;
+                case Phase::Close:
+                    request.fd = -1;
+                    break;
+                }
+            }
+            __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Submit queued entries and block until that many have completed
+ * @return false if the kernel rejected the submission
+ */
+bool UringReader::submitAndWait_(unsigned toSubmit) {
+    unsigned submitted = 0;
+    while (submitted < toSubmit) {
+        const int result = ioUringEnter(m_ringFd, toSubmit - submitted, toSubmit - submitted,
+                                        IORING_ENTER_GETEVENTS);
+        if (result < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            return false;
+        }
+        submitted += static_cast<unsigned>(result);
+    }
+    return true;
+}
+
+} // namespace procfs